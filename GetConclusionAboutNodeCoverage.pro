@@ -1,16 +1,13 @@
-QT += core testlib  # testlib для QTest, core для QObject
+QT += core testlib concurrent network  # testlib для QTest, core для QObject, concurrent для пула потоков, network для локального сокета
 CONFIG += c++17 qttest  # qttest для корректной работы Qt Test
 
 TARGET = TestApp
+
+include(treecoverage.pri)  # исходные файлы анализатора
+
 SOURCES += \
-    error.cpp \
     main.cpp \
-    node.cpp \
-    tests.cpp \
-    treecoverageanalyzer.cpp
+    tests.cpp
 
 HEADERS += \
-    error.h \
-    node.h \
-    tests.h \
-    treecoverageanalyzer.h
+    tests.h
@@ -0,0 +1,177 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса AllocationProfiler и считающие функции выделения памяти:
+* malloc, calloc, realloc и free в Linux с glibc, глобальные operator new и operator delete на остальных платформах.
+*/
+
+#include "allocationprofiler.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<qint64> allocationCount(0); //!< количество выделений
+static std::atomic<qint64> freeCount(0); //!< количество освобождений
+static std::atomic<qint64> allocatedBytes(0); //!< количество выделенных байт
+
+// В glibc функции malloc можно заменить определением в программе, исходные доступны как __libc_malloc и т.д.
+#if defined(TREECOVERAGE_ALLOCATION_PROFILER) && defined(__linux__) && defined(__GLIBC__)
+#define TREECOVERAGE_ALLOCATION_MALLOC
+#endif
+
+bool AllocationProfiler::isEnabled() {
+#ifdef TREECOVERAGE_ALLOCATION_PROFILER
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* AllocationProfiler::source() {
+#if defined(TREECOVERAGE_ALLOCATION_MALLOC)
+    return "malloc";
+#elif defined(TREECOVERAGE_ALLOCATION_PROFILER)
+    return "operator new";
+#else
+    return "none";
+#endif
+}
+
+AllocationProfiler::Counters AllocationProfiler::snapshot() {
+    Counters counters;
+    counters.allocations = allocationCount.load(std::memory_order_relaxed);
+    counters.frees = freeCount.load(std::memory_order_relaxed);
+    counters.bytes = allocatedBytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+/*!
+* \brief Учитывает выделение
+* \param [in] size - размер в байтах
+*/
+static inline void countAllocation(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(static_cast<qint64>(size), std::memory_order_relaxed);
+}
+
+#if defined(TREECOVERAGE_ALLOCATION_MALLOC)
+
+extern "C" {
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+void __libc_free(void* pointer);
+
+// Замена видна и библиотекам Qt, поэтому учитываются данные QList, QString, QByteArray и объекты, создаваемые через new
+void* malloc(std::size_t size) noexcept {
+    void* pointer = __libc_malloc(size);
+    if (pointer) {
+        countAllocation(size);
+    }
+    return pointer;
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept {
+    void* pointer = __libc_calloc(count, size);
+    if (pointer) {
+        countAllocation(count * size);
+    }
+    return pointer;
+}
+
+void* realloc(void* pointer, std::size_t size) noexcept {
+    // Перевыделение считается освобождением старого блока и выделением нового, при ошибке старый блок остается
+    void* result = __libc_realloc(pointer, size);
+    if (pointer && (result || size == 0)) {
+        freeCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (result) {
+        countAllocation(size);
+    }
+    return result;
+}
+
+void free(void* pointer) noexcept {
+    if (pointer) {
+        freeCount.fetch_add(1, std::memory_order_relaxed);
+        __libc_free(pointer);
+    }
+}
+
+}
+
+#elif defined(TREECOVERAGE_ALLOCATION_PROFILER)
+
+/*!
+* \brief Выделяет память и учитывает выделение
+* \param [in] size - размер в байтах
+* \return указатель на память или nullptr, если ее не хватило
+*/
+static void* countedAllocate(std::size_t size) {
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer) {
+        countAllocation(size);
+    }
+    return pointer;
+}
+
+/*!
+* \brief Освобождает память и учитывает освобождение
+* \param [in] pointer - указатель на память (nullptr не учитывается)
+*/
+static void countedFree(void* pointer) noexcept {
+    if (pointer) {
+        freeCount.fetch_add(1, std::memory_order_relaxed);
+        std::free(pointer);
+    }
+}
+
+void* operator new(std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    void* pointer = countedAllocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer);
+}
+
+#endif // TREECOVERAGE_ALLOCATION_MALLOC
@@ -0,0 +1,53 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса AllocationProfiler, считающего выделения памяти.
+*/
+
+#ifndef ALLOCATIONPROFILER_H
+#define ALLOCATIONPROFILER_H
+
+#include <QtGlobal>
+
+/*!
+* \brief Класс счетчиков выделений памяти.
+*
+* Счетчики ведутся, только если программа собрана с CONFIG+=allocation_profiler (определение TREECOVERAGE_ALLOCATION_PROFILER).
+* В Linux с glibc заменяются malloc, calloc, realloc и free, поэтому учитывается вся куча процесса, включая данные
+* QList, QString и QByteArray. На остальных платформах заменяются только глобальные operator new и operator delete:
+* учитываются узлы Node, таблицы QHash и QSet и прочие объекты, создаваемые через new, но не данные контейнеров,
+* выделяемые через malloc. Какие функции считаются, сообщает source(). Счетчики общие для всех потоков.
+*/
+class AllocationProfiler
+{
+public:
+    /*!
+    * \brief Значения счетчиков на момент снимка
+    */
+    class Counters
+    {
+    public:
+        qint64 allocations = 0; //!< количество выделений
+        qint64 frees = 0; //!< количество освобождений
+        qint64 bytes = 0; //!< количество байт, запрошенных у считаемых функций выделения (см. source())
+    };
+
+    /*!
+    * \brief Проверяет, собрана ли программа со считающими функциями выделения памяти
+    * \return true - если счетчики ведутся
+    */
+    static bool isEnabled();
+
+    /*!
+    * \brief Возвращает считаемые функции выделения памяти
+    * \return "malloc" - вся куча (Linux с glibc), "operator new" - только объекты, создаваемые через new, "none" - счетчики не ведутся
+    */
+    static const char* source();
+
+    /*!
+    * \brief Возвращает текущие значения счетчиков
+    * \return счетчики с начала работы программы (нули, если счетчики не ведутся)
+    */
+    static Counters snapshot();
+};
+
+#endif // ALLOCATIONPROFILER_H
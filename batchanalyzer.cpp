@@ -0,0 +1,339 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса BatchAnalyzer.
+*/
+
+#include "batchanalyzer.h"
+#include "boundedqueue.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+/*!
+* \brief Экранирует поле CSV, если оно содержит разделитель, кавычку или перевод строки
+* \param [in] field - значение поля
+* \return поле, пригодное для записи в CSV
+*/
+static QString csvField(const QString& field) {
+    if (!field.contains(',') && !field.contains('"') && !field.contains('\n')) {
+        return field;
+    }
+    QString escaped = field;
+    escaped.replace("\"", "\"\"");
+    return "\"" + escaped + "\"";
+}
+
+BatchAnalyzer::BatchAnalyzer()
+    : threadCount(0), suggestionCount(0), resultFormat(TreeCoverageAnalyzer::TextFormat), isPipelined(false), queueCapacity(64), resultCache(nullptr), trace(nullptr), limits(nullptr), failedCount(0) {}
+
+bool BatchAnalyzer::collectInputs(const QString& source) {
+    inputFiles.clear();
+    const QFileInfo sourceInfo(source);
+
+    // 1. Каталог: все файлы *.dot в порядке имен
+    if (sourceInfo.isDir()) {
+        const QDir directory(source);
+        const QStringList fileNames = directory.entryList(QStringList() << "*.dot", QDir::Files, QDir::Name);
+        for (const QString& fileName : fileNames) {
+            inputFiles.append(directory.filePath(fileName));
+        }
+        return true;
+    }
+
+    // 2. Файл-список: по одному пути в строке, пустые строки пропускаются
+    QFile listFile(source);
+    if (!listFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream in(&listFile);
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        if (!line.isEmpty()) {
+            inputFiles.append(line);
+        }
+    }
+    listFile.close();
+    return true;
+}
+
+QStringList BatchAnalyzer::resultFileNames() const {
+    const QString extension = resultFormat == TreeCoverageAnalyzer::JsonFormat ? ".json" : ".txt";
+    const QDir directory(outputDirectory);
+    QStringList resultFiles;
+    QSet<QString> usedNames;
+    usedNames.insert("summary");
+    for (int i = 0; i < inputFiles.size(); ++i) {
+        // Файлы с одинаковыми именами из разных каталогов получают номер строки списка
+        QString baseName = QFileInfo(inputFiles[i]).completeBaseName();
+        if (usedNames.contains(baseName)) {
+            baseName += QString("_%1").arg(i + 1);
+        }
+        usedNames.insert(baseName);
+        resultFiles.append(directory.filePath(baseName + extension));
+    }
+    return resultFiles;
+}
+
+BatchAnalyzer::Item BatchAnalyzer::analyzeFile(const QString& inputFile, const QString& resultFile) const {
+    Item item;
+    item.inputFile = inputFile;
+    item.resultFile = resultFile;
+    TraceRecorder::Span fileSpan(trace, "file", "batch", inputFile);
+    QElapsedTimer timer;
+    timer.start();
+
+    // 1. Читаем входной файл
+    TraceRecorder::Span readSpan(trace, "read", "batch", inputFile);
+    QFile file(inputFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return item;
+    }
+    const QByteArray buffer = file.readAll();
+    file.close();
+    item.isRead = true;
+    readSpan.finish();
+
+    // 2. Анализируем собственным экземпляром анализатора и записываем результат
+    TreeCoverageAnalyzer analyzer;
+    analyzer.suggestionCount = suggestionCount;
+    analyzer.resultCache = resultCache;
+    analyzer.trace = trace;
+    analyzer.limits = limits;
+    const CoverageResult result = analyzer.analyzeBuffer(buffer);
+    finishItem(item, analyzer, result.status);
+    item.elapsedMs = timer.elapsed();
+    return item;
+}
+
+void BatchAnalyzer::finishItem(Item& item, TreeCoverageAnalyzer& analyzer, CoverageResult::Status status) const {
+    analyzer.resultFormat = resultFormat;
+    item.isWritten = analyzer.writeResultFile(item.resultFile);
+
+    // Сохраняем только счетчики, узлы анализатора удаляются вместе с ним
+    item.status = status;
+    item.errorCount = analyzer.errors.size();
+    item.extraCount = analyzer.extraNodes.size();
+    item.redundantCount = analyzer.redundantNodes.size();
+    item.missingCount = analyzer.missingNodes.size();
+}
+
+CoverageResult::Status BatchAnalyzer::analyzeWithCache(TreeCoverageAnalyzer& analyzer) const {
+    if (!resultCache) {
+        return analyzer.analyzeValidTree();
+    }
+
+    // Дерево уже проверено стадией разбора, из кэша берется только результат обхода
+    const QByteArray cacheKey = ResultCache::key(analyzer.structureHash(), analyzer);
+    CoverageResult cached;
+    if (resultCache->find(cacheKey, cached)) {
+        analyzer.applyResult(cached);
+        return cached.status;
+    }
+    const CoverageResult::Status status = analyzer.analyzeValidTree();
+    resultCache->insert(cacheKey, analyzer.buildResult(status));
+    return status;
+}
+
+bool BatchAnalyzer::run() {
+    failedCount = 0;
+    QDir().mkpath(outputDirectory);
+    QFile summaryFile(QDir(outputDirectory).filePath("summary.csv"));
+    if (!summaryFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream summary(&summaryFile);
+    summary << "input,result,status,errors,extra,redundant,missing,elapsed_ms\n";
+
+    if (isPipelined) {
+        runPipeline(summary);
+    }
+    else {
+        runMapped(summary);
+    }
+
+    summaryFile.close();
+    return true;
+}
+
+void BatchAnalyzer::runMapped(QTextStream& summary) {
+    QList<QPair<QString, QString>> jobs;
+    const QStringList resultFiles = resultFileNames();
+    for (int i = 0; i < inputFiles.size(); ++i) {
+        jobs.append(qMakePair(inputFiles[i], resultFiles[i]));
+    }
+
+    // Собственный пул, чтобы количество потоков не зависело от глобального пула программы
+    QThreadPool pool;
+    if (threadCount > 0) {
+        pool.setMaxThreadCount(threadCount);
+    }
+    QFuture<Item> future = QtConcurrent::mapped(&pool, jobs, [this](const QPair<QString, QString>& job) {
+        return analyzeFile(job.first, job.second);
+    });
+
+    // resultAt ожидает только i-й результат, поэтому строки таблицы пишутся, пока остальные файлы анализируются
+    for (int i = 0; i < jobs.size(); ++i) {
+        const Item item = future.resultAt(i);
+        if (!item.isRead || !item.isWritten) {
+            failedCount++;
+        }
+        writeSummaryLine(summary, item);
+    }
+    future.waitForFinished();
+}
+
+/*!
+* \brief Содержимое входного файла, прочитанное стадией чтения
+*/
+struct ReadJob {
+    int index; //!< номер входного файла
+    BatchAnalyzer::Item item; //!< итог анализа, заполняемый по мере прохождения стадий
+    QByteArray buffer; //!< содержимое файла
+};
+
+/*!
+* \brief Дерево, разобранное и проверенное стадией разбора
+*/
+struct ParsedJob {
+    int index; //!< номер входного файла
+    BatchAnalyzer::Item item; //!< итог анализа, заполняемый по мере прохождения стадий
+    TreeCoverageAnalyzer* analyzer; //!< анализатор с разобранным деревом, удаляется стадией анализа
+    bool isValid; //!< дерево прошло проверку
+    CoverageResult::Status status; //!< итог проверки, если дерево ее не прошло
+};
+
+void BatchAnalyzer::runPipeline(QTextStream& summary) {
+    const QStringList resultFiles = resultFileNames();
+    const int totalThreads = threadCount > 0 ? threadCount : QThread::idealThreadCount();
+    const int parserCount = qMax(1, totalThreads / 2);
+    const int analyzerCount = qMax(1, totalThreads - parserCount);
+
+    BoundedQueue<ReadJob> readQueue(queueCapacity, 1);
+    BoundedQueue<ParsedJob> parsedQueue(queueCapacity, parserCount);
+    BoundedQueue<QPair<int, Item>> resultQueue(queueCapacity, analyzerCount);
+
+    // Поток чтения и потоки стадий ожидают на очередях, поэтому пулу нужно по потоку на каждого участника
+    QThreadPool pool;
+    pool.setMaxThreadCount(1 + parserCount + analyzerCount);
+
+    // 1. Стадия чтения заранее загружает содержимое файлов, скрывая задержку диска за разбором и анализом
+    QtConcurrent::run(&pool, [&]() {
+        for (int i = 0; i < inputFiles.size(); ++i) {
+            ReadJob job;
+            job.index = i;
+            job.item.inputFile = inputFiles[i];
+            job.item.resultFile = resultFiles[i];
+            TraceRecorder::Span span(trace, "read", "batch", inputFiles[i]);
+            QElapsedTimer timer;
+            timer.start();
+            QFile file(inputFiles[i]);
+            if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                job.buffer = file.readAll();
+                file.close();
+                job.item.isRead = true;
+            }
+            job.item.elapsedMs = timer.elapsed();
+            span.finish();
+            readQueue.push(job);
+        }
+        readQueue.producerFinished();
+    });
+
+    // 2. Стадия разбора строит дерево и проверяет его
+    for (int i = 0; i < parserCount; ++i) {
+        QtConcurrent::run(&pool, [&]() {
+            ReadJob readJob;
+            while (readQueue.pop(readJob)) {
+                ParsedJob job;
+                job.index = readJob.index;
+                job.item = readJob.item;
+                job.analyzer = nullptr;
+                job.isValid = false;
+                job.status = CoverageResult::Covered;
+                if (job.item.isRead) {
+                    TraceRecorder::Span span(trace, "parse", "batch", job.item.inputFile);
+                    QElapsedTimer timer;
+                    timer.start();
+                    job.analyzer = new TreeCoverageAnalyzer();
+                    job.analyzer->trace = trace;
+                    job.analyzer->limits = limits;
+                    job.isValid = job.analyzer->validate(QString::fromUtf8(readJob.buffer), job.status);
+                    job.item.elapsedMs += timer.elapsed();
+                }
+                readJob.buffer.clear();
+                parsedQueue.push(job);
+            }
+            parsedQueue.producerFinished();
+        });
+    }
+
+    // 3. Стадия анализа вычисляет покрытие и записывает результат файла
+    for (int i = 0; i < analyzerCount; ++i) {
+        QtConcurrent::run(&pool, [&]() {
+            ParsedJob job;
+            while (parsedQueue.pop(job)) {
+                if (job.analyzer != nullptr) {
+                    TraceRecorder::Span span(trace, "analyze", "batch", job.item.inputFile);
+                    QElapsedTimer timer;
+                    timer.start();
+                    CoverageResult::Status status = job.status;
+                    if (job.isValid) {
+                        // Время ожидания в очереди конвейера не засчитывается в ограничение по времени
+                        job.analyzer->restartLimits();
+                        job.analyzer->suggestionCount = suggestionCount;
+                        status = analyzeWithCache(*job.analyzer);
+                    }
+                    finishItem(job.item, *job.analyzer, status);
+                    delete job.analyzer;
+                    job.item.elapsedMs += timer.elapsed();
+                }
+                resultQueue.push(qMakePair(job.index, job.item));
+            }
+            resultQueue.producerFinished();
+        });
+    }
+
+    // 4. Итоговая таблица пишется в порядке входных файлов, опередившие результаты ждут своей очереди
+    QMap<int, Item> pendingItems;
+    int nextIndex = 0;
+    QPair<int, Item> result;
+    while (resultQueue.pop(result)) {
+        pendingItems.insert(result.first, result.second);
+        while (!pendingItems.isEmpty() && pendingItems.firstKey() == nextIndex) {
+            const Item item = pendingItems.take(nextIndex);
+            if (!item.isRead || !item.isWritten) {
+                failedCount++;
+            }
+            writeSummaryLine(summary, item);
+            nextIndex++;
+        }
+    }
+    pool.waitForDone();
+}
+
+void BatchAnalyzer::writeSummaryLine(QTextStream& out, const Item& item) {
+    out << csvField(item.inputFile) << ',' << csvField(item.isWritten ? item.resultFile : QString()) << ','
+        << statusName(item) << ',' << item.errorCount << ',' << item.extraCount << ','
+        << item.redundantCount << ',' << item.missingCount << ',' << item.elapsedMs << '\n';
+}
+
+QString BatchAnalyzer::statusName(const Item& item) {
+    if (!item.isRead) {
+        return "ReadError";
+    }
+    switch (item.status) {
+    case CoverageResult::Covered: return "Covered";
+    case CoverageResult::NotCovered: return "NotCovered";
+    case CoverageResult::ParseErrors: return "ParseErrors";
+    case CoverageResult::GraphErrors: return "GraphErrors";
+    case CoverageResult::Canceled: return "Canceled";
+    case CoverageResult::LimitExceeded: return "LimitExceeded";
+    }
+    return QString();
+}
@@ -0,0 +1,132 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса BatchAnalyzer, анализирующего множество DOT-файлов на пуле потоков.
+*/
+
+#ifndef BATCHANALYZER_H
+#define BATCHANALYZER_H
+
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include "treecoverageanalyzer.h"
+
+/*!
+* \brief Класс пакетного анализа: каждый входной файл анализируется собственным экземпляром TreeCoverageAnalyzer.
+*
+* Результат каждого файла записывается в отдельный файл выходного каталога, итоговая таблица summary.csv
+* дописывается по мере готовности результатов в порядке входных файлов.
+*/
+class BatchAnalyzer
+{
+public:
+    /*!
+    * \brief Итог анализа одного входного файла, хранящий только счетчики, чтобы память не росла с размером деревьев
+    */
+    class Item
+    {
+    public:
+        QString inputFile; //!< имя входного файла
+        QString resultFile; //!< имя файла с результатом
+        bool isRead = false; //!< входной файл прочитан
+        bool isWritten = false; //!< файл с результатом записан
+        CoverageResult::Status status = CoverageResult::Covered; //!< итог анализа
+        int errorCount = 0; //!< количество ошибок во входных данных
+        int extraCount = 0; //!< количество лишних узлов
+        int redundantCount = 0; //!< количество избыточных узлов
+        int missingCount = 0; //!< количество недостающих узлов
+        qint64 elapsedMs = 0; //!< время анализа файла в миллисекундах
+    };
+
+    /*!
+    * \brief Конструктор по умолчанию для класса BatchAnalyzer
+    */
+    BatchAnalyzer();
+
+    QStringList inputFiles; //!< входные DOT-файлы в порядке обработки
+    QString outputDirectory; //!< каталог для результатов и итоговой таблицы
+    int threadCount; //!< количество потоков пула (0 - по числу ядер)
+    int suggestionCount; //!< количество предлагаемых для отметки узлов (0 - не предлагать)
+    TreeCoverageAnalyzer::ResultFormat resultFormat; //!< формат файлов с результатами
+    bool isPipelined; //!< чтение, разбор и анализ выполняются отдельными стадиями конвейера
+    int queueCapacity; //!< емкость очередей между стадиями конвейера
+    ResultCache* resultCache; //!< общий для потоков кэш результатов (nullptr - не используется)
+    TraceRecorder* trace; //!< общая для потоков трассировка, в которой каждый файл - отрезок потока пула (nullptr - не ведется)
+    const ResourceLimits* limits; //!< ограничения ресурсов на каждый файл (nullptr - без ограничений)
+    int failedCount; //!< количество файлов, которые не удалось прочитать или записать
+
+    /*!
+    * \brief Собирает входные файлы из каталога (все файлы *.dot) или из файла-списка (по одному пути в строке)
+    * \param [in] source - каталог или файл-список
+    * \param [out] inputFiles - найденные входные файлы
+    * \return true - если источник прочитан, false - в противном случае
+    */
+    bool collectInputs(const QString& source);
+
+    /*!
+    * \brief Подбирает для каждого входного файла уникальное имя файла с результатом в выходном каталоге
+    * \return список имен файлов с результатами в порядке inputFiles
+    */
+    QStringList resultFileNames() const;
+
+    /*!
+    * \brief Анализирует один входной файл отдельным анализатором и записывает его результат
+    * \param [in] inputFile - входной файл
+    * \param [in] resultFile - файл для записи результата
+    * \return итог анализа файла
+    */
+    Item analyzeFile(const QString& inputFile, const QString& resultFile) const;
+
+    /*!
+    * \brief Записывает результат проверенного или проанализированного дерева и переносит счетчики в итог файла
+    * \param [in,out] item - итог анализа файла
+    * \param [in] analyzer - анализатор файла
+    * \param [in] status - итог анализа
+    */
+    void finishItem(Item& item, TreeCoverageAnalyzer& analyzer, CoverageResult::Status status) const;
+
+    /*!
+    * \brief Анализирует покрытие проверенного дерева, беря результат из кэша, если он задан и содержит такую же пару (дерево, отметки)
+    * \param [in,out] analyzer - анализатор с проверенным деревом
+    * \return итог анализа
+    */
+    CoverageResult::Status analyzeWithCache(TreeCoverageAnalyzer& analyzer) const;
+
+    /*!
+    * \brief Анализирует все входные файлы на пуле потоков и записывает итоговую таблицу summary.csv
+    * \param [out] failedCount - количество файлов, которые не удалось прочитать или записать
+    * \return true - если итоговая таблица записана, false - если ее не удалось открыть
+    */
+    bool run();
+
+    /*!
+    * \brief Анализирует каждый файл целиком одной задачей пула: чтение, разбор, анализ и запись подряд
+    * \param [out] summary - поток итоговой таблицы
+    */
+    void runMapped(QTextStream& summary);
+
+    /*!
+    * \brief Анализирует файлы конвейером: стадия чтения, стадия разбора и проверки, стадия анализа и записи
+    *
+    * Стадии связаны очередями емкости queueCapacity, поэтому в памяти одновременно находится ограниченное число
+    * прочитанных файлов и разобранных деревьев, а чтение следующих файлов идет параллельно с анализом предыдущих.
+    * \param [out] summary - поток итоговой таблицы
+    */
+    void runPipeline(QTextStream& summary);
+
+    /*!
+    * \brief Записывает строку итоговой таблицы для одного входного файла
+    * \param [out] out - поток итоговой таблицы
+    * \param [in] item - итог анализа файла
+    */
+    static void writeSummaryLine(QTextStream& out, const Item& item);
+
+    /*!
+    * \brief Возвращает название итога анализа файла для итоговой таблицы
+    * \param [in] item - итог анализа файла
+    * \return название итога
+    */
+    static QString statusName(const Item& item);
+};
+
+#endif // BATCHANALYZER_H
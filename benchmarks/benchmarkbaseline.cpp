@@ -0,0 +1,126 @@
+/*!
+ * \file
+ * \brief Файл содержит реализацию методов класса BenchmarkBaseline.
+ */
+
+#include "benchmarkbaseline.h"
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QXmlStreamReader>
+#include "jsonstreamwriter.h"
+
+bool BenchmarkBaseline::readTestOutput(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    results.clear();
+
+    // Результаты лежат в <TestFunction name="..."><BenchmarkResult metric="..." tag="..." value="..." iterations="..."/>
+    QXmlStreamReader xml(&file);
+    QString function;
+    while (!xml.atEnd()) {
+        xml.readNext();
+        if (!xml.isStartElement()) {
+            continue;
+        }
+        if (xml.name() == QLatin1String("TestFunction")) {
+            function = xml.attributes().value("name").toString();
+        }
+        else if (xml.name() == QLatin1String("BenchmarkResult")) {
+            Result result;
+            result.function = function;
+            result.tag = xml.attributes().value("tag").toString();
+            result.metric = xml.attributes().value("metric").toString();
+            result.value = xml.attributes().value("value").toDouble();
+            result.iterations = xml.attributes().value("iterations").toInt();
+            results.append(result);
+        }
+    }
+    return !xml.hasError();
+}
+
+bool BenchmarkBaseline::read(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        return false;
+    }
+    results.clear();
+    for (const QJsonValue& value : document.object().value("results").toArray()) {
+        const QJsonObject object = value.toObject();
+        Result result;
+        result.function = object.value("function").toString();
+        result.tag = object.value("tag").toString();
+        result.metric = object.value("metric").toString();
+        result.value = object.value("value").toDouble();
+        result.iterations = object.value("iterations").toInt();
+        results.append(result);
+    }
+    return true;
+}
+
+bool BenchmarkBaseline::write(const QString& fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    JsonStreamWriter json(out);
+    json.beginObject();
+    json.key("results");
+    json.beginArray();
+    for (const Result& result : results) {
+        json.beginObject();
+        json.key("function");
+        json.value(result.function);
+        json.key("tag");
+        json.value(result.tag);
+        json.key("metric");
+        json.value(result.metric);
+        json.key("value");
+        json.value(result.value);
+        json.key("iterations");
+        json.value(result.iterations);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    out << "\n";
+    out.flush();
+    return true;
+}
+
+QStringList BenchmarkBaseline::compare(const BenchmarkBaseline& baseline, double timeThreshold, double allocationThreshold) const {
+    QHash<QString, double> baselineValues;
+    for (const Result& result : baseline.results) {
+        baselineValues.insert(result.key(), result.value);
+    }
+
+    QStringList regressions;
+    for (const Result& result : results) {
+        if (!baselineValues.contains(result.key())) {
+            continue;
+        }
+        const double baselineValue = baselineValues.value(result.key());
+        const double threshold = isAllocationMetric(result.metric) ? allocationThreshold : timeThreshold;
+        if (result.value > baselineValue * (1.0 + threshold / 100.0)) {
+            const QString growth = baselineValue > 0 ? "+" + QString::number((result.value / baselineValue - 1.0) * 100.0, 'f', 1) + "%" : QString("рост с нуля");
+            regressions.append(QString("%1(%2) %3: %4 -> %5 (%6)").arg(result.function, result.tag, result.metric)
+                               .arg(baselineValue).arg(result.value).arg(growth));
+        }
+    }
+    return regressions;
+}
+
+bool BenchmarkBaseline::isAllocationMetric(const QString& metric) {
+    return metric == QLatin1String("Events") || metric == QLatin1String("BytesAllocated");
+}
@@ -0,0 +1,80 @@
+/*!
+* \file
+* \brief Заголовочный файл класса BenchmarkBaseline для сохранения результатов замеров и сравнения с ними.
+*/
+
+#ifndef BENCHMARKBASELINE_H
+#define BENCHMARKBASELINE_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \brief Класс набора результатов замеров: читается из XML-вывода QtTest, сохраняется и загружается как JSON.
+ *
+ * Для всех величин, которые сообщают замеры (время, количество выделений, выделенные байты), больше значит хуже,
+ * поэтому регрессией считается рост значения больше допустимого процента.
+ */
+class BenchmarkBaseline
+{
+public:
+    /*!
+    * \brief Результат одного замера
+    */
+    class Result
+    {
+    public:
+        QString function; //!< имя функции замера
+        QString tag; //!< имя строки данных
+        QString metric; //!< величина в терминах QtTest (WalltimeMilliseconds, Events, BytesAllocated, ...)
+        double value = 0.0; //!< значение за одну итерацию
+        int iterations = 0; //!< количество итераций замера
+
+        /*!
+        * \brief Возвращает ключ, по которому сопоставляются замеры двух наборов
+        */
+        QString key() const { return function + ":" + tag + ":" + metric; }
+    };
+
+    QList<Result> results; //!< результаты в порядке выполнения замеров
+
+    /*!
+    * \brief Читает результаты из файла, записанного QtTest с параметром -o file,xml
+    * \param [in] fileName - имя файла
+    * \return true - если файл прочитан без ошибок
+    */
+    bool readTestOutput(const QString& fileName);
+
+    /*!
+    * \brief Загружает результаты из файла базовой линии
+    * \param [in] fileName - имя файла
+    * \return true - если файл прочитан без ошибок
+    */
+    bool read(const QString& fileName);
+
+    /*!
+    * \brief Сохраняет результаты в файл базовой линии
+    * \param [in] fileName - имя файла
+    * \return true - если файл записан
+    */
+    bool write(const QString& fileName) const;
+
+    /*!
+    * \brief Сравнивает результаты с базовой линией
+    * \param [in] baseline - базовая линия
+    * \param [in] timeThreshold - допустимый рост времени в процентах
+    * \param [in] allocationThreshold - допустимый рост количества выделений и выделенных байт в процентах
+    * \return описания замеров, ухудшившихся больше допустимого (замеры, которых нет в базовой линии, не сравниваются)
+    */
+    QStringList compare(const BenchmarkBaseline& baseline, double timeThreshold, double allocationThreshold) const;
+
+    /*!
+    * \brief Проверяет, относится ли величина к выделениям памяти
+    * \param [in] metric - величина в терминах QtTest
+    * \return true - для Events и BytesAllocated
+    */
+    static bool isAllocationMetric(const QString& metric);
+};
+
+#endif // BENCHMARKBASELINE_H
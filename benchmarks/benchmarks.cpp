@@ -0,0 +1,245 @@
+/*!
+ * \file
+ * \brief Файл содержит реализацию методов класса Benchmarks для замеров производительности функций программы GetConclusionAboutNodeCoverage.
+ */
+
+#include "benchmarks.h"
+#include <QTemporaryDir>
+
+QString Benchmarks::generateTree(DotGenerator::TreeShape shape, int size) {
+    // Постоянное зерно дает одно и то же дерево при каждом запуске
+    DotGenerator generator;
+    generator.shape = shape;
+    generator.size = size;
+    generator.selectedDensity = 1.0 / 7;
+    return generator.generate();
+}
+
+void Benchmarks::addTreeRows() {
+    QTest::addColumn<DotGenerator::TreeShape>("shape");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<Benchmarks::Measurement>("measurement");
+
+    for (DotGenerator::TreeShape shape : {DotGenerator::ChainTree, DotGenerator::StarTree, DotGenerator::BalancedTree, DotGenerator::RandomTree}) {
+        for (int size = 1000; size <= 10000000; size *= 10) {
+            const QByteArray shapeName = DotGenerator::shapeName(shape).toLatin1();
+            QTest::addRow("%s_%d", shapeName.constData(), size) << shape << size << WallTime;
+            if (AllocationProfiler::isEnabled()) {
+                QTest::addRow("%s_%d_allocations", shapeName.constData(), size) << shape << size << AllocationCount;
+                QTest::addRow("%s_%d_allocated_bytes", shapeName.constData(), size) << shape << size << AllocatedBytes;
+            }
+        }
+    }
+}
+
+bool Benchmarks::isSkipped(DotGenerator::TreeShape shape, int size, bool isRecursive, QByteArray& reason) {
+    bool isNumber = false;
+    int maxSize = qEnvironmentVariableIntValue("TREECOVERAGE_BENCHMARK_MAX_SIZE", &isNumber);
+    if (!isNumber) {
+        maxSize = DefaultMaxSize;
+    }
+    if (size > maxSize) {
+        reason = "размер больше TREECOVERAGE_BENCHMARK_MAX_SIZE=" + QByteArray::number(maxSize);
+        return true;
+    }
+    if (isRecursive && shape == DotGenerator::ChainTree && size > MaxRecursionDepth) {
+        reason = "глубина цепочки больше допустимой глубины рекурсии " + QByteArray::number(MaxRecursionDepth);
+        return true;
+    }
+    return false;
+}
+
+void Benchmarks::prepareValidTree(DotGenerator::TreeShape shape, int size, TreeCoverageAnalyzer& analyzer) {
+    CoverageResult::Status status;
+    QVERIFY(analyzer.validate(generateTree(shape, size), status));
+}
+
+void Benchmarks::clearValidation(TreeCoverageAnalyzer& analyzer) {
+    analyzer.rootNodes.clear();
+    analyzer.cycles.clear();
+    analyzer.multiParents.clear();
+    analyzer.amountOfParents.clear();
+    analyzer.visitedNodes.clear();
+    analyzer.errors.clear();
+    analyzer.isConnected = false;
+}
+
+void Benchmarks::parseDOT_benchmark() {
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QByteArray reason;
+    if (isSkipped(shape, size, false, reason)) {
+        QSKIP(reason.constData());
+    }
+    const QString content = generateTree(shape, size);
+
+    // Замер: разбор вместе с удалением узлов предыдущего разбора
+    TreeCoverageAnalyzer analyzer;
+    measure([&]() {
+        analyzer.parseDOT(content);
+    });
+    QCOMPARE(analyzer.treeMap.size(), size);
+}
+void Benchmarks::parseDOT_benchmark_data() {
+    addTreeRows();
+}
+
+void Benchmarks::fillHash_benchmark() {
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QByteArray reason;
+    if (isSkipped(shape, size, true, reason)) {
+        QSKIP(reason.constData());
+    }
+    TreeCoverageAnalyzer analyzer;
+    analyzer.parseDOT(generateTree(shape, size));
+
+    // Замер: подсчет родителей и проверка графа на дерево
+    measure([&]() {
+        clearValidation(analyzer);
+        analyzer.fillHash(analyzer.treeMap, analyzer.amountOfParents);
+    });
+    QVERIFY(analyzer.errors.isEmpty());
+}
+void Benchmarks::fillHash_benchmark_data() {
+    addTreeRows();
+}
+
+void Benchmarks::treeGraphTakeErrors_benchmark() {
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QByteArray reason;
+    if (isSkipped(shape, size, true, reason)) {
+        QSKIP(reason.constData());
+    }
+    TreeCoverageAnalyzer analyzer;
+    prepareValidTree(shape, size, analyzer);
+    const QHash<Node*, int> amountOfParents = analyzer.amountOfParents;
+
+    // Замер: поиск корней, узлов с несколькими родителями, циклов и проверка связности по готовой таблице родителей
+    measure([&]() {
+        clearValidation(analyzer);
+        analyzer.amountOfParents = amountOfParents;
+        analyzer.treeGraphTakeErrors(analyzer.amountOfParents);
+    });
+    QVERIFY(analyzer.errors.isEmpty());
+}
+void Benchmarks::treeGraphTakeErrors_benchmark_data() {
+    addTreeRows();
+}
+
+void Benchmarks::hasCycles_benchmark() {
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QByteArray reason;
+    if (isSkipped(shape, size, true, reason)) {
+        QSKIP(reason.constData());
+    }
+    TreeCoverageAnalyzer analyzer;
+    prepareValidTree(shape, size, analyzer);
+    Node* root = *analyzer.rootNodes.begin();
+
+    // Замер: обход дерева от корня с поиском циклов
+    measure([&]() {
+        analyzer.visitedNodes.clear();
+        QList<Node*> currentPath;
+        analyzer.hasCycles(root, currentPath);
+    });
+    QCOMPARE(analyzer.visitedNodes.size(), size);
+}
+void Benchmarks::hasCycles_benchmark_data() {
+    addTreeRows();
+}
+
+void Benchmarks::analyzeZoneWithExtraNodes_benchmark() {
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QByteArray reason;
+    if (isSkipped(shape, size, true, reason)) {
+        QSKIP(reason.constData());
+    }
+    TreeCoverageAnalyzer analyzer;
+    prepareValidTree(shape, size, analyzer);
+    Node* root = *analyzer.rootNodes.begin();
+
+    // Замер: обход от корня, включающий зоны избыточных и недостающих узлов
+    measure([&]() {
+        analyzer.clearCoverage();
+        analyzer.analyzeZoneWithExtraNodes(root);
+    });
+}
+void Benchmarks::analyzeZoneWithExtraNodes_benchmark_data() {
+    addTreeRows();
+}
+
+void Benchmarks::analyzeZoneWithMissingNodes_benchmark() {
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QByteArray reason;
+    if (isSkipped(shape, size, true, reason)) {
+        QSKIP(reason.constData());
+    }
+    TreeCoverageAnalyzer analyzer;
+    prepareValidTree(shape, size, analyzer);
+    Node* target = nullptr;
+    for (Node* node : analyzer.treeMap) {
+        if (node->shape == Node::Target) {
+            target = node;
+            break;
+        }
+    }
+    QVERIFY(target != nullptr);
+
+    // Замер: поиск недостающих узлов в поддереве целевого узла
+    measure([&]() {
+        analyzer.clearCoverage();
+        analyzer.analyzeZoneWithMissingNodes(target);
+    });
+}
+void Benchmarks::analyzeZoneWithMissingNodes_benchmark_data() {
+    addTreeRows();
+}
+
+void Benchmarks::analyzeZoneWithRedundantNodes_benchmark() {
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QByteArray reason;
+    if (isSkipped(shape, size, true, reason)) {
+        QSKIP(reason.constData());
+    }
+    TreeCoverageAnalyzer analyzer;
+    prepareValidTree(shape, size, analyzer);
+    Node* root = *analyzer.rootNodes.begin();
+
+    // Замер: корень считается отмеченным предком, поэтому все отмеченные узлы до целевого узла избыточны
+    measure([&]() {
+        analyzer.clearCoverage();
+        analyzer.analyzeZoneWithRedundantNodes(root, root);
+    });
+}
+void Benchmarks::analyzeZoneWithRedundantNodes_benchmark_data() {
+    addTreeRows();
+}
+
+void Benchmarks::getResult_benchmark() {
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QByteArray reason;
+    if (isSkipped(shape, size, true, reason)) {
+        QSKIP(reason.constData());
+    }
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    TreeCoverageAnalyzer analyzer;
+    prepareValidTree(shape, size, analyzer);
+    analyzer.analyzeCoverage();
+    analyzer.resultFileName = directory.filePath("coverage_result.txt");
+
+    // Замер: упорядочивание результата и запись файла вывода
+    measure([&]() {
+        analyzer.getResult();
+    });
+}
+void Benchmarks::getResult_benchmark_data() {
+    addTreeRows();
+}
@@ -0,0 +1,128 @@
+/*!
+* \file
+* \brief Заголовочный файл класса Benchmarks для замеров производительности функций программы GetConclusionAboutNodeCoverage.
+*/
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include "allocationprofiler.h"
+#include "treecoverageanalyzer.h"
+#include "dotgenerator.h"
+
+/*!
+ * \brief Класс замеров производительности: каждая функция анализатора замеряется на деревьях разного размера и формы.
+ *
+ * Размеры деревьев от 1e3 до 1e7 узлов. Деревья больше TREECOVERAGE_BENCHMARK_MAX_SIZE (по умолчанию 1e5) пропускаются,
+ * чтобы обычный запуск занимал минуты. Рекурсивные функции не замеряются на цепочках глубже MaxRecursionDepth,
+ * так как переполнение стека завершило бы все замеры.
+ * В сборке с CONFIG+=allocation_profiler у каждого дерева есть еще строки _allocations и _allocated_bytes:
+ * в них вместо времени сообщается количество выделений и выделенных байт за одно выполнение замеряемого кода.
+ */
+class Benchmarks : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DefaultMaxSize = 100000; //!< наибольший размер дерева без переменной окружения
+    static constexpr int MaxRecursionDepth = 5000; //!< наибольшая глубина цепочки для рекурсивных функций
+
+    /*!
+    * \brief перечисление измеряемых величин
+    */
+    enum Measurement {
+        WallTime,
+        AllocationCount,
+        AllocatedBytes
+    };
+
+    /*!
+    * \brief Генерирует DOT-контент дерева: корень n0, целевой узел n1, каждый седьмой из остальных узлов в среднем отмечен
+    * \param [in] shape - форма дерева
+    * \param [in] size - количество узлов
+    * \return содержимое DOT-файла
+    */
+    static QString generateTree(DotGenerator::TreeShape shape, int size);
+
+    /*!
+    * \brief Добавляет строки данных для всех сочетаний формы и размера дерева
+    */
+    static void addTreeRows();
+
+    /*!
+    * \brief Проверяет, нужно ли пропустить замер на дереве заданной формы и размера
+    * \param [in] shape - форма дерева
+    * \param [in] size - количество узлов
+    * \param [in] isRecursive - замеряемая функция обходит дерево рекурсией
+    * \param [out] reason - причина пропуска
+    * \return true - если замер нужно пропустить
+    */
+    static bool isSkipped(DotGenerator::TreeShape shape, int size, bool isRecursive, QByteArray& reason);
+
+    /*!
+    * \brief Разбирает и проверяет дерево, подготавливая анализатор к замерам анализа покрытия
+    * \param [in] shape - форма дерева
+    * \param [in] size - количество узлов
+    * \param [out] analyzer - анализатор с проверенным деревом
+    */
+    static void prepareValidTree(DotGenerator::TreeShape shape, int size, TreeCoverageAnalyzer& analyzer);
+
+    /*!
+    * \brief Сбрасывает результаты проверки графа, чтобы ее можно было повторить на тех же узлах
+    * \param [in,out] analyzer - анализатор
+    */
+    static void clearValidation(TreeCoverageAnalyzer& analyzer);
+
+    /*!
+    * \brief Замеряет код величиной из столбца measurement: временем через QBENCHMARK или выделениями памяти за одно выполнение
+    * \param [in] body - замеряемый код
+    */
+    template <typename Body>
+    static void measure(Body body) {
+        QFETCH(Benchmarks::Measurement, measurement);
+        if (measurement == WallTime) {
+            QBENCHMARK {
+                body();
+            }
+            return;
+        }
+        const AllocationProfiler::Counters before = AllocationProfiler::snapshot();
+        body();
+        const AllocationProfiler::Counters after = AllocationProfiler::snapshot();
+        if (measurement == AllocationCount) {
+            QTest::setBenchmarkResult(after.allocations - before.allocations, QTest::Events);
+        }
+        else {
+            QTest::setBenchmarkResult(after.bytes - before.bytes, QTest::BytesAllocated);
+        }
+    }
+
+private slots:
+    void parseDOT_benchmark();
+    void parseDOT_benchmark_data();
+
+    void fillHash_benchmark();
+    void fillHash_benchmark_data();
+
+    void treeGraphTakeErrors_benchmark();
+    void treeGraphTakeErrors_benchmark_data();
+
+    void hasCycles_benchmark();
+    void hasCycles_benchmark_data();
+
+    void analyzeZoneWithExtraNodes_benchmark();
+    void analyzeZoneWithExtraNodes_benchmark_data();
+
+    void analyzeZoneWithMissingNodes_benchmark();
+    void analyzeZoneWithMissingNodes_benchmark_data();
+
+    void analyzeZoneWithRedundantNodes_benchmark();
+    void analyzeZoneWithRedundantNodes_benchmark_data();
+
+    void getResult_benchmark();
+    void getResult_benchmark_data();
+};
+
+#endif // BENCHMARKS_H
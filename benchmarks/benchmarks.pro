@@ -0,0 +1,15 @@
+QT += core testlib concurrent network  # testlib для QBENCHMARK, остальные модули нужны исходным файлам анализатора
+CONFIG += c++17 qttest console
+
+TARGET = BenchmarkApp
+
+include(../treecoverage.pri)  # исходные файлы анализатора
+
+SOURCES += \
+    benchmarkbaseline.cpp \
+    benchmarks.cpp \
+    main.cpp
+
+HEADERS += \
+    benchmarkbaseline.h \
+    benchmarks.h
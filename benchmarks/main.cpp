@@ -0,0 +1,104 @@
+/*!
+ * \file
+ * \brief Файл содержит точку входа программы замеров BenchmarkApp: запуск замеров, сохранение базовой линии и сравнение с ней.
+ */
+
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+#include "benchmarkbaseline.h"
+#include "benchmarks.h"
+
+/*!
+ * \brief Извлекает параметр со значением из аргументов, чтобы остальные аргументы можно было передать QtTest
+ * \param [in,out] arguments - аргументы запуска
+ * \param [in] name - имя параметра
+ * \param [out] value - значение параметра
+ * \return true - если параметр найден
+ */
+static bool takeOption(QStringList& arguments, const QString& name, QString& value) {
+    const int index = arguments.indexOf(name);
+    if (index < 1 || index + 1 >= arguments.size()) {
+        return false;
+    }
+    value = arguments.at(index + 1);
+    arguments.remove(index, 2);
+    return true;
+}
+
+/*!
+ * \brief Главная функция программы замеров
+ *
+ * Помимо параметров QtTest программа принимает:
+ * --save-baseline file - сохранить результаты замеров в файл базовой линии;
+ * --compare-baseline file - сравнить результаты с базовой линией;
+ * --threshold percent - допустимый рост времени (по умолчанию 10%);
+ * --allocation-threshold percent - допустимый рост количества выделений и выделенных байт (по умолчанию 0%).
+ * \return 0 - замеры выполнены без ошибок и регрессий; иначе количество проваленных замеров или 1 при регрессии
+ */
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QTEST_SET_MAIN_SOURCE_PATH
+    QStringList arguments = app.arguments();
+
+    // 1. Параметры базовой линии
+    QString saveFile;
+    QString compareFile;
+    QString thresholdText = "10";
+    QString allocationThresholdText = "0";
+    const bool isSaving = takeOption(arguments, "--save-baseline", saveFile);
+    const bool isComparing = takeOption(arguments, "--compare-baseline", compareFile);
+    takeOption(arguments, "--threshold", thresholdText);
+    takeOption(arguments, "--allocation-threshold", allocationThresholdText);
+    bool isThresholdNumber = false;
+    bool isAllocationThresholdNumber = false;
+    const double threshold = thresholdText.toDouble(&isThresholdNumber);
+    const double allocationThreshold = allocationThresholdText.toDouble(&isAllocationThresholdNumber);
+    if (!isThresholdNumber || !isAllocationThresholdNumber || threshold < 0 || allocationThreshold < 0) {
+        qCritical() << "Ошибка: пороги --threshold и --allocation-threshold должны быть неотрицательными числами";
+        return 1;
+    }
+
+    // 2. Замеры: для базовой линии результаты дополнительно записываются в XML, вывод в консоль сохраняется
+    Benchmarks benchmarks;
+    if (!isSaving && !isComparing) {
+        return QTest::qExec(&benchmarks, arguments);
+    }
+    QTemporaryDir directory;
+    if (!directory.isValid()) {
+        qCritical() << "Ошибка: не удалось создать временный каталог для результатов замеров";
+        return 1;
+    }
+    const QString resultFile = directory.filePath("benchmarks.xml");
+    arguments << "-o" << resultFile + ",xml" << "-o" << "-,txt";
+    const int failedCount = QTest::qExec(&benchmarks, arguments);
+
+    BenchmarkBaseline current;
+    if (!current.readTestOutput(resultFile)) {
+        qCritical() << "Ошибка при чтении результатов замеров:" << resultFile;
+        return 1;
+    }
+
+    // 3. Сохранение базовой линии
+    if (isSaving && !current.write(saveFile)) {
+        qCritical() << "Ошибка при записи базовой линии в файл:" << saveFile;
+        return 1;
+    }
+
+    // 4. Сравнение с базовой линией
+    if (isComparing) {
+        BenchmarkBaseline baseline;
+        if (!baseline.read(compareFile)) {
+            qCritical() << "Ошибка при чтении базовой линии из файла:" << compareFile;
+            return 1;
+        }
+        const QStringList regressions = current.compare(baseline, threshold, allocationThreshold);
+        for (const QString& regression : regressions) {
+            qCritical().noquote() << "Регрессия:" << regression;
+        }
+        if (!regressions.isEmpty()) {
+            return 1;
+        }
+    }
+    return failedCount;
+}
@@ -0,0 +1,82 @@
+/*!
+* \file
+* \brief Файл содержит шаблон класса BoundedQueue – очереди ограниченной емкости для передачи данных между стадиями конвейера.
+*/
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <QMutex>
+#include <QQueue>
+#include <QWaitCondition>
+
+/*!
+* \brief Потокобезопасная очередь ограниченной емкости.
+*
+* Поставщик блокируется, пока очередь заполнена, поэтому быстрая стадия конвейера не может опередить медленную
+* больше чем на capacity элементов. Очередь закрывается, когда все поставщики сообщили о завершении.
+*/
+template <typename T>
+class BoundedQueue
+{
+public:
+    /*!
+    * \brief Конструктор очереди
+    * \param [in] capacity - максимальное количество элементов в очереди
+    * \param [in] producerCount - количество поставщиков, после завершения которых очередь закрывается
+    */
+    BoundedQueue(int capacity, int producerCount = 1)
+        : capacity(capacity > 0 ? capacity : 1), producerCount(producerCount) {}
+
+    /*!
+    * \brief Добавляет элемент, ожидая освобождения места
+    * \param [in] item - элемент
+    */
+    void push(const T& item) {
+        QMutexLocker locker(&mutex);
+        while (items.size() >= capacity) {
+            notFull.wait(&mutex);
+        }
+        items.enqueue(item);
+        notEmpty.wakeOne();
+    }
+
+    /*!
+    * \brief Извлекает элемент, ожидая его появления
+    * \param [out] item - извлеченный элемент
+    * \return true - элемент извлечен, false - очередь пуста и все поставщики завершились
+    */
+    bool pop(T& item) {
+        QMutexLocker locker(&mutex);
+        while (items.isEmpty() && producerCount > 0) {
+            notEmpty.wait(&mutex);
+        }
+        if (items.isEmpty()) {
+            return false;
+        }
+        item = items.dequeue();
+        notFull.wakeOne();
+        return true;
+    }
+
+    /*!
+    * \brief Сообщает о завершении одного из поставщиков, после последнего пробуждает всех ожидающих потребителей
+    */
+    void producerFinished() {
+        QMutexLocker locker(&mutex);
+        producerCount--;
+        if (producerCount <= 0) {
+            notEmpty.wakeAll();
+        }
+    }
+
+private:
+    QQueue<T> items; //!< элементы очереди
+    int capacity; //!< максимальное количество элементов
+    int producerCount; //!< количество незавершившихся поставщиков
+    QMutex mutex; //!< защищает элементы и счетчик поставщиков
+    QWaitCondition notFull; //!< сигнал об освободившемся месте
+    QWaitCondition notEmpty; //!< сигнал о новом элементе или закрытии очереди
+};
+
+#endif // BOUNDEDQUEUE_H
@@ -0,0 +1,221 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса CoverageDaemon.
+*/
+
+#include "coveragedaemon.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+CoverageDaemon::CoverageDaemon()
+    : resultCache(nullptr), limits(nullptr) {}
+
+CoverageDaemon::~CoverageDaemon() {
+    // Сокеты удаляются вместе с сервером, отключаем их сигналы, чтобы они не обращались к удаленным сеансам
+    server.close();
+    for (QLocalSocket* socket : sessions.keys()) {
+        socket->disconnect();
+    }
+    sessions.clear();
+    qDeleteAll(trees);
+    trees.clear();
+}
+
+bool CoverageDaemon::listen(const QString& name) {
+    QLocalServer::removeServer(name);
+    if (!server.listen(name)) {
+        return false;
+    }
+    QObject::connect(&server, &QLocalServer::newConnection, &server, [this]() {
+        acceptConnections();
+    });
+    return true;
+}
+
+void CoverageDaemon::acceptConnections() {
+    while (server.hasPendingConnections()) {
+        QLocalSocket* socket = server.nextPendingConnection();
+        sessions.insert(socket, Session());
+        QObject::connect(socket, &QLocalSocket::readyRead, &server, [this, socket]() {
+            readRequests(socket);
+        });
+        QObject::connect(socket, &QLocalSocket::disconnected, &server, [this, socket]() {
+            sessions.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void CoverageDaemon::readRequests(QLocalSocket* socket) {
+    Session& session = sessions[socket];
+    session.pending += socket->readAll();
+
+    // Отвечаем на каждую завершенную строку, остаток ждет следующей порции данных
+    int lineEnd = session.pending.indexOf('\n');
+    while (lineEnd >= 0) {
+        const QString line = QString::fromUtf8(session.pending.left(lineEnd)).trimmed();
+        session.pending.remove(0, lineEnd + 1);
+        if (!line.isEmpty()) {
+            socket->write(handleRequest(session, line));
+        }
+        lineEnd = session.pending.indexOf('\n');
+    }
+}
+
+QByteArray CoverageDaemon::handleRequest(Session& session, const QString& line) {
+    const QString command = line.section(' ', 0, 0).toUpper();
+    const QString argument = line.section(' ', 1).trimmed();
+    QString error;
+
+    // 1. Загрузка дерева
+    if (command == "LOAD") {
+        ResidentTree* tree = residentTree(argument, error);
+        if (tree == nullptr) {
+            return "ERROR " + error.toUtf8() + "\n";
+        }
+        session.path = argument;
+        session.hasSelection = false;
+        session.selection.clear();
+        return "OK " + QByteArray::number(tree->analyzer.treeMap.size()) + "\n";
+    }
+
+    // 2. Отметки узлов проверяются сразу, чтобы ошибка в имени не обнаружилась только при анализе
+    if (command == "SELECT") {
+        ResidentTree* tree = residentTree(session.path, error);
+        if (tree == nullptr) {
+            return "ERROR " + error.toUtf8() + "\n";
+        }
+        QStringList selection;
+        for (const QString& name : argument.split(',', Qt::SkipEmptyParts)) {
+            selection.append(name.trimmed());
+        }
+        QStringList invalidNames;
+        if (!tree->analyzer.selectNodes(selection, invalidNames)) {
+            return "ERROR нельзя отметить узлы: " + invalidNames.join(", ").toUtf8() + "\n";
+        }
+        session.hasSelection = true;
+        session.selection = selection;
+        return "OK " + QByteArray::number(selection.size()) + "\n";
+    }
+
+    // 3. Анализ покрытия, результат передается с длиной, так как может занимать несколько строк
+    if (command == "RESULT") {
+        if (!argument.isEmpty() && argument != "text" && argument != "json") {
+            return "ERROR неизвестный формат вывода " + argument.toUtf8() + "\n";
+        }
+        const TreeCoverageAnalyzer::ResultFormat format = argument == "json" ? TreeCoverageAnalyzer::JsonFormat : TreeCoverageAnalyzer::TextFormat;
+        QByteArray payload;
+        if (!analyzeSession(session, format, error, payload)) {
+            return "ERROR " + error.toUtf8() + "\n";
+        }
+        return "OK " + QByteArray::number(payload.size()) + "\n" + payload;
+    }
+
+    return "ERROR неизвестная команда " + command.toUtf8() + "\n";
+}
+
+CoverageDaemon::ResidentTree* CoverageDaemon::residentTree(const QString& path, QString& error) {
+    if (path.isEmpty()) {
+        error = "дерево не загружено";
+        return nullptr;
+    }
+    const QFileInfo fileInfo(path);
+    if (!fileInfo.isFile()) {
+        error = "не удалось открыть файл " + path;
+        return nullptr;
+    }
+
+    // 1. Неизменившийся файл не разбирается повторно
+    const QString key = fileInfo.absoluteFilePath();
+    const QDateTime modified = fileInfo.lastModified();
+    ResidentTree* tree = trees.value(key, nullptr);
+    if (tree != nullptr && tree->modified == modified) {
+        return tree;
+    }
+
+    // 2. Разбираем и проверяем файл
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = "не удалось открыть файл " + path;
+        return nullptr;
+    }
+    const QString content = QString::fromUtf8(file.readAll());
+    file.close();
+
+    ResidentTree* loadedTree = new ResidentTree();
+    loadedTree->analyzer.limits = limits;
+    CoverageResult::Status status;
+    if (!loadedTree->analyzer.validate(content, status)) {
+        QStringList messages;
+        for (const Error& treeError : loadedTree->analyzer.errors) {
+            messages.append(treeError.errMessage());
+        }
+        error = messages.join("; ");
+        delete loadedTree;
+        return nullptr;
+    }
+    loadedTree->modified = modified;
+    loadedTree->structure = loadedTree->analyzer.structureHash();
+    for (Node* node : loadedTree->analyzer.treeMap) {
+        if (node->shape == Node::Selected) {
+            loadedTree->fileSelection.append(node->name);
+        }
+    }
+
+    // 3. Заменяем устаревшую версию дерева
+    delete tree;
+    trees.insert(key, loadedTree);
+    return loadedTree;
+}
+
+bool CoverageDaemon::analyzeSession(const Session& session, TreeCoverageAnalyzer::ResultFormat format, QString& error, QByteArray& payload) {
+    ResidentTree* tree = residentTree(session.path, error);
+    if (tree == nullptr) {
+        return false;
+    }
+
+    // 1. Дерево общее для сеансов, поэтому перед анализом применяются отметки этого сеанса
+    TreeCoverageAnalyzer& analyzer = tree->analyzer;
+    QStringList invalidNames;
+    if (!analyzer.selectNodes(session.hasSelection ? session.selection : tree->fileSelection, invalidNames)) {
+        error = "в измененном дереве нет узлов: " + invalidNames.join(", ");
+        return false;
+    }
+
+    // 2. Анализ без повторного разбора, повторяющиеся отметки берутся из кэша без обхода дерева
+    const QByteArray cacheKey = resultCache ? ResultCache::key(tree->structure, analyzer) : QByteArray();
+    CoverageResult cached;
+    if (resultCache && resultCache->find(cacheKey, cached)) {
+        analyzer.applyResult(cached);
+    }
+    else {
+        // Время каждого запроса отсчитывается заново, прерванный ограничением анализ не портит дерево
+        analyzer.clearCoverage();
+        analyzer.restartLimits();
+        const CoverageResult::Status status = analyzer.analyzeValidTree();
+        if (status == CoverageResult::LimitExceeded) {
+            error = analyzer.errors.last().errMessage();
+            analyzer.restartLimits();
+            return false;
+        }
+        if (resultCache) {
+            resultCache->insert(cacheKey, analyzer.buildResult(status));
+        }
+    }
+
+    // 3. Запись результата в буфер
+    QTextStream out(&payload);
+    if (format == TreeCoverageAnalyzer::JsonFormat) {
+        JsonStreamWriter json(out);
+        json.beginObject();
+        analyzer.writeJsonResult(json);
+        json.endObject();
+        out << "\n";
+    }
+    else {
+        analyzer.writeResult(out);
+    }
+    out.flush();
+    return true;
+}
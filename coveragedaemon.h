@@ -0,0 +1,115 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса CoverageDaemon, отвечающего на запросы о покрытии через локальный сокет.
+*/
+
+#ifndef COVERAGEDAEMON_H
+#define COVERAGEDAEMON_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QString>
+#include <QStringList>
+#include "treecoverageanalyzer.h"
+
+/*!
+* \brief Класс резидентного режима: разобранные и проверенные деревья хранятся в памяти между запросами.
+*
+* Протокол строковый, каждая команда - одна строка в UTF-8:
+* - LOAD <путь> - загрузить дерево (повторно разбирается только при изменении времени модификации файла), ответ "OK <узлов>";
+* - SELECT [имя,имя,...] - задать отметки узлов для следующих запросов сеанса, ответ "OK <отмечено>";
+* - RESULT [text|json] - проанализировать покрытие, ответ "OK <байт>" и следом ровно столько байт результата.
+* При ошибке ответ "ERROR <сообщение>".
+*/
+class CoverageDaemon
+{
+public:
+    /*!
+    * \brief Дерево, хранящееся в памяти демона
+    */
+    class ResidentTree
+    {
+    public:
+        QDateTime modified; //!< время модификации файла, по которому дерево было разобрано
+        TreeCoverageAnalyzer analyzer; //!< анализатор с разобранным и проверенным деревом
+        QStringList fileSelection; //!< отмеченные узлы в самом файле
+        QByteArray structure; //!< хэш структуры дерева для ключей кэша результатов
+    };
+
+    /*!
+    * \brief Состояние одного подключения
+    */
+    class Session
+    {
+    public:
+        QString path; //!< путь загруженного дерева
+        bool hasSelection = false; //!< отметки заданы командой SELECT
+        QStringList selection; //!< отметки сеанса
+        QByteArray pending; //!< принятые байты незавершенной строки
+    };
+
+    /*!
+    * \brief Конструктор по умолчанию для класса CoverageDaemon
+    */
+    CoverageDaemon();
+
+    /*!
+    * \brief Деструктор, освобождающий деревья и сеансы
+    */
+    ~CoverageDaemon();
+
+    QLocalServer server; //!< локальный сервер (Unix-сокет или именованный канал Windows)
+    QHash<QString, ResidentTree*> trees; //!< деревья в памяти по абсолютному пути файла
+    QHash<QLocalSocket*, Session> sessions; //!< сеансы подключенных клиентов
+    ResultCache* resultCache; //!< кэш результатов для повторяющихся пар (дерево, отметки), nullptr - не используется
+    const ResourceLimits* limits; //!< ограничения ресурсов на загрузку и каждый анализ дерева (nullptr - без ограничений)
+
+    /*!
+    * \brief Начинает прием подключений
+    * \param [in] name - имя или путь локального сокета, оставшийся от прошлого запуска сокет удаляется
+    * \return true - если сокет открыт, false - в противном случае
+    */
+    bool listen(const QString& name);
+
+    /*!
+    * \brief Принимает новые подключения и связывает их чтение с обработкой запросов
+    */
+    void acceptConnections();
+
+    /*!
+    * \brief Читает из сокета завершенные строки и отвечает на каждую из них
+    * \param [in] socket - подключение клиента
+    */
+    void readRequests(QLocalSocket* socket);
+
+    /*!
+    * \brief Выполняет одну команду протокола
+    * \param [in,out] session - состояние подключения
+    * \param [in] line - строка команды без перевода строки
+    * \return ответ, готовый к отправке клиенту
+    */
+    QByteArray handleRequest(Session& session, const QString& line);
+
+    /*!
+    * \brief Возвращает дерево из памяти, разбирая файл заново только если он изменился
+    * \param [in] path - путь к DOT-файлу
+    * \param [out] error - сообщение об ошибке
+    * \return дерево или nullptr при ошибке чтения или проверки
+    */
+    ResidentTree* residentTree(const QString& path, QString& error);
+
+    /*!
+    * \brief Анализирует покрытие дерева сеанса с отметками сеанса
+    * \param [in] session - состояние подключения
+    * \param [in] format - формат результата
+    * \param [out] error - сообщение об ошибке
+    * \param [out] payload - результат анализа
+    * \return true - если анализ выполнен, false - в противном случае
+    */
+    bool analyzeSession(const Session& session, TreeCoverageAnalyzer::ResultFormat format, QString& error, QByteArray& payload);
+};
+
+#endif // COVERAGEDAEMON_H
@@ -0,0 +1,335 @@
+/*!
+* \file
+* \brief Файл содержит шаблон класса CoverageEngine – анализ покрытия с выбором стратегий хранения дерева, множеств и обхода при компиляции.
+*/
+
+#ifndef COVERAGEENGINE_H
+#define COVERAGEENGINE_H
+
+#include <QList>
+#include <QPair>
+#include <QSet>
+#include <QVector>
+#include "coveragepolicies.h"
+#include "treecoverageanalyzer.h"
+
+/*!
+* \brief Шаблон анализа покрытия по трем зонам – единственная реализация правил зон, которую используют
+* TreeCoverageAnalyzer, CoverageQuery и варианты для сравнения.
+*
+* TreePolicy задает представление дерева (PointerTreePolicy, FlatTreePolicy), SetPolicy – множества лишних и
+* недостающих узлов (HashSetPolicy, BitSetPolicy), TraversalPolicy – способ обхода (RecursiveTraversal, IterativeTraversal),
+* HooksPolicy – действия при обходе, не меняющие правил зон (NoCoverageHooks, действия анализатора).
+* Правила зон записаны как действия при входе в узел, при возврате из ребенка и при выходе из узла,
+* поэтому рекурсивный и итеративный обходы выполняют одни и те же правила.
+*/
+template <typename TreePolicy, typename SetPolicy, typename TraversalPolicy, typename HooksPolicy = NoCoverageHooks>
+class CoverageEngine
+{
+public:
+    typedef TreeCoverageAnalyzer::CoverageStatus Status;
+
+    /*!
+    * \brief перечисление зон анализа
+    */
+    enum Zone {
+        ExtraZone,
+        MissingZone,
+        RedundantZone
+    };
+
+    /*!
+    * \brief Кадр обхода: узел, его зона и состояние подсчета статусов детей
+    */
+    class Frame
+    {
+    public:
+        int node = -1; //!< номер узла
+        Zone zone = ExtraZone; //!< зона, в которой анализируется узел
+        int selectedNode = -1; //!< отмеченный предок в зоне избыточных узлов
+        int childCount = 0; //!< количество детей, которые нужно обойти
+        int nextChild = 0; //!< позиция следующего ребенка при итеративном обходе
+        bool allFullyCovered = true; //!< все дети полностью покрыты
+        bool allNotCovered = true; //!< все дети не покрыты
+        bool hasCoveredChild = false; //!< есть полностью или частично покрытый ребенок
+        bool isStopped = false; //!< обход узла прерван действиями при обходе (отмена анализа)
+        bool isReused = false; //!< статус узла взят из предыдущего анализа без обхода поддерева
+        Status reusedStatus = TreeCoverageAnalyzer::NotCovered; //!< статус переиспользованного поддерева
+    };
+
+    /*!
+    * \brief Конструктор, строящий представление дерева из узлов, достижимых из начальных
+    * \param [in] startNodes - начальные узлы (корень дерева и при необходимости отмеченный предок для зоны избыточных узлов)
+    */
+    explicit CoverageEngine(const QList<Node*>& startNodes) {
+        tree.build(startNodes);
+        resetResults();
+    }
+
+    /*!
+    * \brief Конструктор для уже построенного представления дерева (узлы задаются номерами)
+    * \param [in] builtTree - представление дерева
+    */
+    explicit CoverageEngine(const TreePolicy& builtTree)
+        : tree(builtTree) {
+        resetResults();
+    }
+
+    TreePolicy tree; //!< представление дерева
+    HooksPolicy hooks; //!< действия при обходе
+    SetPolicy extraNodes; //!< лишние узлы
+    SetPolicy missingNodes; //!< узлы, которых не хватает для покрытия
+    QList<QPair<int, int>> redundantNodes; //!< пары (отмеченный предок, избыточный узел)
+    QVector<Status> childStatuses; //!< статусы узлов в зоне недостающих узлов, нужные родителю при выходе
+
+    /*!
+    * \brief Очищает результаты под текущий размер дерева
+    */
+    void resetResults() {
+        extraNodes.reset(tree.size());
+        missingNodes.reset(tree.size());
+        redundantNodes.clear();
+        childStatuses.fill(TreeCoverageAnalyzer::NotCovered, tree.size());
+    }
+
+    /*!
+    * \brief Анализирует покрытие дерева, начиная с корня, заданного номером
+    * \param [in] root - номер корня дерева
+    */
+    void analyzeTree(int root) {
+        if (root >= 0 && root < tree.size()) {
+            TraversalPolicy::run(*this, makeFrame(root, ExtraZone, -1));
+        }
+    }
+
+    /*!
+    * \brief Анализирует покрытие зоны в которой возможно находятся лишние узлы (используется TreeCoverageAnalyzer::analyzeZoneWithExtraNodes)
+    * \param [in] node - начальный узел
+    */
+    void analyzeZoneWithExtraNodes(Node* node) {
+        if (node) {
+            TraversalPolicy::run(*this, makeFrame(tree.indices.value(node), ExtraZone, -1));
+        }
+    }
+
+    /*!
+    * \brief Анализирует покрытие зоны недостающих узлов (используется TreeCoverageAnalyzer::analyzeZoneWithMissingNodes)
+    * \param [in] node - начальный узел
+    * \return статус покрытия узла
+    */
+    Status analyzeZoneWithMissingNodes(Node* node) {
+        if (!node) {
+            return TreeCoverageAnalyzer::NotCovered;
+        }
+        return TraversalPolicy::run(*this, makeFrame(tree.indices.value(node), MissingZone, -1));
+    }
+
+    /*!
+    * \brief Анализирует покрытие зоны избыточных узлов (используется TreeCoverageAnalyzer::analyzeZoneWithRedundantNodes)
+    * \param [in] node - начальный узел
+    * \param [in] selectedNode - отмеченный предок
+    */
+    void analyzeZoneWithRedundantNodes(Node* node, Node* selectedNode) {
+        if (node) {
+            TraversalPolicy::run(*this, makeFrame(tree.indices.value(node), RedundantZone, tree.indices.value(selectedNode, -1)));
+        }
+    }
+
+    /*!
+    * \brief Создает кадр узла в заданной зоне
+    */
+    Frame makeFrame(int node, Zone zone, int selectedNode) const {
+        Frame frame;
+        frame.node = node;
+        frame.zone = zone;
+        frame.selectedNode = selectedNode;
+        return frame;
+    }
+
+    /*!
+    * \brief Действия при входе в узел: запись лишних и избыточных узлов и выбор детей для обхода
+    * \param [in,out] frame - кадр узла
+    */
+    void enter(Frame& frame) {
+        const Node::Shape shape = tree.shape(frame.node);
+        if (!hooks.visit(*this, frame.node, frame.zone)) {
+            frame.isStopped = true;
+            return;
+        }
+
+        // Целевой узел в зоне лишних узлов начинает зону недостающих узлов
+        if (frame.zone == ExtraZone && shape == Node::Target) {
+            frame.zone = MissingZone;
+            if (!hooks.visit(*this, frame.node, frame.zone)) {
+                frame.isStopped = true;
+                return;
+            }
+        }
+
+        // Поддерево в зоне недостающих узлов может взять статус из предыдущего анализа и не обходиться
+        if (frame.zone == MissingZone && hooks.reuse(*this, frame.node, frame.reusedStatus)) {
+            frame.isReused = true;
+            return;
+        }
+        if (frame.zone == ExtraZone && shape == Node::Selected) {
+            extraNodes.insert(frame.node);
+        }
+        if (frame.zone == RedundantZone && shape == Node::Selected) {
+            redundantNodes.append(qMakePair(frame.selectedNode, frame.node));
+        }
+        frame.childCount = tree.childCount(frame.node);
+    }
+
+    /*!
+    * \brief Создает кадр ребенка в зоне, которую задает родитель
+    * \param [in] parent - кадр родителя
+    * \param [in] child - номер ребенка
+    * \return кадр ребенка
+    */
+    Frame childFrame(const Frame& parent, int child) const {
+        const Node::Shape shape = tree.shape(parent.node);
+        if (parent.zone == RedundantZone) {
+            return shape == Node::Target ? makeFrame(child, MissingZone, -1) : makeFrame(child, RedundantZone, parent.selectedNode);
+        }
+        if (shape == Node::Selected) {
+            return makeFrame(child, RedundantZone, parent.node);
+        }
+        return makeFrame(child, parent.zone, -1);
+    }
+
+    /*!
+    * \brief Учитывает статус ребенка в зоне недостающих узлов
+    * \param [in,out] parent - кадр родителя
+    * \param [in] child - номер ребенка
+    * \param [in] status - статус ребенка
+    */
+    void childDone(Frame& parent, int child, Status status) {
+        if (parent.zone != MissingZone || tree.shape(parent.node) == Node::Selected) {
+            return;
+        }
+        childStatuses[child] = status;
+        if (status == TreeCoverageAnalyzer::FullyCovered) {
+            parent.allNotCovered = false;
+            parent.hasCoveredChild = true;
+        }
+        else if (status == TreeCoverageAnalyzer::PartiallyCovered) {
+            parent.allFullyCovered = false;
+            parent.allNotCovered = false;
+            parent.hasCoveredChild = true;
+        }
+        else {
+            parent.allFullyCovered = false;
+        }
+    }
+
+    /*!
+    * \brief Действия при выходе из узла: статус покрытия и недостающие узлы
+    * \param [in] frame - кадр узла
+    * \return статус покрытия узла (имеет смысл только в зоне недостающих узлов)
+    */
+    Status exit(const Frame& frame) {
+        if (frame.isStopped) {
+            return TreeCoverageAnalyzer::NotCovered;
+        }
+
+        // Корень переиспользованного поддерева недостающий только при статусе NotCovered, родитель может позже его убрать
+        Status status = TreeCoverageAnalyzer::NotCovered;
+        if (frame.zone == MissingZone && !frame.isReused) {
+            status = missingZoneStatus(frame);
+        }
+        else if (frame.zone == MissingZone) {
+            status = frame.reusedStatus;
+            if (status == TreeCoverageAnalyzer::NotCovered) {
+                missingNodes.insert(frame.node);
+            }
+        }
+        hooks.leave(*this, frame.node, frame.zone, status);
+        return status;
+    }
+
+    /*!
+    * \brief Вычисляет статус покрытия узла в зоне недостающих узлов по статусам детей
+    * \param [in] frame - кадр узла
+    * \return статус покрытия узла
+    */
+    Status missingZoneStatus(const Frame& frame) {
+        const Node::Shape shape = tree.shape(frame.node);
+
+        // 1. Целевой узел: без детей частично покрыт, иначе покрыт, если покрыты все дети
+        if (shape == Node::Target) {
+            return frame.childCount > 0 && frame.allFullyCovered ? TreeCoverageAnalyzer::FullyCovered : TreeCoverageAnalyzer::PartiallyCovered;
+        }
+
+        // 2. Отмеченный узел покрывает свое поддерево
+        if (shape == Node::Selected) {
+            return TreeCoverageAnalyzer::FullyCovered;
+        }
+
+        // 3. Непокрытый лист
+        if (frame.childCount == 0) {
+            missingNodes.insert(frame.node);
+            return TreeCoverageAnalyzer::NotCovered;
+        }
+        if (frame.allFullyCovered) {
+            return TreeCoverageAnalyzer::FullyCovered;
+        }
+
+        // 4. Все дети не покрыты: вместо них отмечать нужно сам узел
+        if (frame.allNotCovered) {
+            for (int position = 0; position < frame.childCount; ++position) {
+                missingNodes.remove(tree.child(frame.node, position));
+            }
+            missingNodes.insert(frame.node);
+            return TreeCoverageAnalyzer::NotCovered;
+        }
+
+        // 5. Часть детей покрыта: непокрытые дети недостающие
+        if (frame.hasCoveredChild) {
+            for (int position = 0; position < frame.childCount; ++position) {
+                const int child = tree.child(frame.node, position);
+                if (childStatuses[child] == TreeCoverageAnalyzer::NotCovered) {
+                    missingNodes.insert(child);
+                }
+            }
+            return TreeCoverageAnalyzer::PartiallyCovered;
+        }
+        return TreeCoverageAnalyzer::NotCovered;
+    }
+
+    /*!
+    * \brief Переводит множество номеров в множество узлов
+    * \param [in] set - множество номеров
+    * \return множество узлов
+    */
+    QSet<Node*> nodeSet(const SetPolicy& set) const {
+        QSet<Node*> result;
+        for (int node : set.values()) {
+            result.insert(tree.nodes[node]);
+        }
+        return result;
+    }
+
+    /*!
+    * \brief Переводит избыточные узлы в множество пар узлов
+    * \return множество пар (отмеченный предок, избыточный узел)
+    */
+    QSet<QPair<Node*, Node*>> redundantNodeSet() const {
+        QSet<QPair<Node*, Node*>> result;
+        for (const QPair<int, int>& pair : redundantNodes) {
+            result.insert(qMakePair(pair.first >= 0 ? tree.nodes[pair.first] : nullptr, tree.nodes[pair.second]));
+        }
+        return result;
+    }
+};
+
+/*!
+* \brief Вариант, повторяющий устройство TreeCoverageAnalyzer: исходные узлы, QSet и рекурсия
+*/
+typedef CoverageEngine<PointerTreePolicy, HashSetPolicy, RecursiveTraversal> ReferenceCoverageEngine;
+
+/*!
+* \brief Вариант для больших деревьев: плоские массивы, битовые множества и обход без рекурсии
+*/
+typedef CoverageEngine<FlatTreePolicy, BitSetPolicy, IterativeTraversal> FastCoverageEngine;
+
+#endif // COVERAGEENGINE_H
@@ -0,0 +1,160 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса CoverageExporter.
+*/
+
+#include "coverageexporter.h"
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QtEndian>
+
+/*!
+* \brief Записывает столбец фиксированной ширины в файл в порядке байтов little-endian
+* \param [in] fileName - имя файла
+* \param [in] column - значения столбца
+* \return true - файл записан, false - в противном случае
+*/
+template <typename T>
+static bool writeColumn(const QString& fileName, const QList<T>& column) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QByteArray bytes(column.size() * static_cast<qsizetype>(sizeof(T)), Qt::Uninitialized);
+    qToLittleEndian<T>(column.constData(), column.size(), bytes.data());
+    const bool written = file.write(bytes) == bytes.size();
+    file.close();
+    return written;
+}
+
+CoverageExporter::CoverageExporter(const TreeCoverageAnalyzer& analyzer)
+    : nodes(analyzer.treeMap) {
+    const int count = nodes.size();
+    parents.fill(NoValue, count);
+    depths.fill(NoValue, count);
+    shapes.resize(count);
+    statuses.fill(NoValue, count);
+    nameOffsets.reserve(count + 1);
+
+    // 1. Номер строки каждого узла, форма и таблица строк
+    QHash<Node*, int> rowOf;
+    rowOf.reserve(count);
+    for (int row = 0; row < count; ++row) {
+        rowOf[nodes[row]] = row;
+        shapes[row] = static_cast<qint8>(nodes[row]->shape);
+        nameOffsets.append(names.size());
+        names.append(nodes[row]->name.toUtf8());
+    }
+    nameOffsets.append(names.size());
+
+    // 2. Корни берутся из анализатора, а в режиме леса - из анализаторов компонент,
+    //    там же хранятся статусы покрытия
+    QList<const TreeCoverageAnalyzer*> sources;
+    sources.append(&analyzer);
+    for (const TreeCoverageAnalyzer* component : analyzer.forest) {
+        sources.append(component);
+    }
+
+    // 3. Родитель и глубина: обход в ширину от корней
+    QList<Node*> queue;
+    for (const TreeCoverageAnalyzer* source : sources) {
+        for (Node* root : source->rootNodes) {
+            if (depths[rowOf.value(root)] == NoValue) {
+                depths[rowOf.value(root)] = 0;
+                queue.append(root);
+            }
+        }
+    }
+    for (int i = 0; i < queue.size(); ++i) {
+        const int row = rowOf.value(queue[i]);
+        for (Node* child : queue[i]->children) {
+            const int childRow = rowOf.value(child);
+            if (depths[childRow] == NoValue) {
+                depths[childRow] = depths[row] + 1;
+                parents[childRow] = row;
+                queue.append(child);
+            }
+        }
+    }
+
+    // 4. Статусы покрытия
+    for (const TreeCoverageAnalyzer* source : sources) {
+        for (auto it = source->nodeStatuses.constBegin(); it != source->nodeStatuses.constEnd(); ++it) {
+            statuses[rowOf.value(it.key())] = static_cast<qint8>(it.value());
+        }
+    }
+}
+
+bool CoverageExporter::writeCsv(const QString& fileName) const {
+    static const char* shapeNames[] = { "Target", "Selected", "Base" };
+    static const char* statusNames[] = { "FullyCovered", "PartiallyCovered", "NotCovered" };
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+
+    // Строки пишутся сразу в буферизованный поток, без сборки всего текста в памяти
+    out << "id,name,shape,depth,parent,status\n";
+    for (int row = 0; row < nodes.size(); ++row) {
+        out << row << ',' << nodes[row]->name << ',' << shapeNames[shapes[row]] << ',';
+        if (depths[row] != NoValue) {
+            out << depths[row];
+        }
+        out << ',';
+        if (parents[row] != NoValue) {
+            out << parents[row];
+        }
+        out << ',';
+        if (statuses[row] != NoValue) {
+            out << statusNames[statuses[row]];
+        }
+        out << '\n';
+    }
+
+    file.close();
+    return out.status() == QTextStream::Ok;
+}
+
+bool CoverageExporter::writeColumns(const QString& directory) const {
+    QDir dir(directory);
+    if (!dir.mkpath(".")) {
+        return false;
+    }
+
+    QList<qint32> ids(nodes.size());
+    for (int row = 0; row < nodes.size(); ++row) {
+        ids[row] = row;
+    }
+
+    bool written = writeColumn(dir.filePath("id.i32"), ids)
+                   && writeColumn(dir.filePath("parent.i32"), parents)
+                   && writeColumn(dir.filePath("depth.i32"), depths)
+                   && writeColumn(dir.filePath("shape.i8"), shapes)
+                   && writeColumn(dir.filePath("status.i8"), statuses)
+                   && writeColumn(dir.filePath("name_offsets.i64"), nameOffsets);
+
+    // Таблица строк
+    QFile namesFile(dir.filePath("names.utf8"));
+    written = written && namesFile.open(QIODevice::WriteOnly) && namesFile.write(names) == names.size();
+    namesFile.close();
+
+    // Описание столбцов для загрузчиков
+    QFile manifestFile(dir.filePath("manifest.txt"));
+    if (!written || !manifestFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream manifest(&manifestFile);
+    manifest << "rows=" << nodes.size() << "\n"
+             << "byte_order=little_endian\n"
+             << "id.i32=int32 номер строки\n"
+             << "parent.i32=int32 номер строки родителя, -1 у корня\n"
+             << "depth.i32=int32 глубина от корня, -1 если узел недостижим из корня\n"
+             << "shape.i8=int8 0 - Target, 1 - Selected, 2 - Base\n"
+             << "status.i8=int8 0 - FullyCovered, 1 - PartiallyCovered, 2 - NotCovered, -1 - не анализировался\n"
+             << "name_offsets.i64=int64 смещения имен в names.utf8, rows+1 значений\n";
+    manifestFile.close();
+    return true;
+}
@@ -0,0 +1,57 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса CoverageExporter, выгружающего покрытие каждого узла для внешних инструментов.
+*/
+
+#ifndef COVERAGEEXPORTER_H
+#define COVERAGEEXPORTER_H
+
+#include <QList>
+#include <QString>
+#include <QByteArray>
+#include "treecoverageanalyzer.h"
+
+/*!
+* \brief Класс для выгрузки покрытия узлов в виде столбцов фиксированной ширины или потока CSV.
+*
+* Строка i соответствует узлу treeMap[i]. Двоичные столбцы записываются в порядке байтов little-endian,
+* имена хранятся в таблице строк: UTF-8 байты всех имен подряд и смещения начала каждого имени.
+*/
+class CoverageExporter
+{
+public:
+    /*!
+    * \brief Значение столбца, если узел не имеет родителя, глубины или статуса покрытия
+    */
+    static constexpr int NoValue = -1;
+
+    /*!
+    * \brief Конструктор, заполняющий столбцы по результатам анализатора
+    * \param [in] analyzer - анализатор, выполнивший анализ покрытия (в том числе в режиме леса)
+    */
+    explicit CoverageExporter(const TreeCoverageAnalyzer& analyzer);
+
+    QList<Node*> nodes; //!< узлы в порядке строк
+    QList<qint32> parents; //!< номер строки родителя узла
+    QList<qint32> depths; //!< глубина узла от корня
+    QList<qint8> shapes; //!< форма узла (значение Node::Shape)
+    QList<qint8> statuses; //!< статус покрытия узла (значение TreeCoverageAnalyzer::CoverageStatus)
+    QByteArray names; //!< таблица строк: имена узлов в UTF-8 подряд
+    QList<qint64> nameOffsets; //!< смещения имен в таблице строк, последний элемент равен ее длине
+
+    /*!
+    * \brief Записывает столбцы потоком CSV
+    * \param [in] fileName - имя выходного файла
+    * \return true - файл записан, false - файл не удалось открыть
+    */
+    bool writeCsv(const QString& fileName) const;
+
+    /*!
+    * \brief Записывает двоичные столбцы и таблицу строк отдельными файлами в каталог
+    * \param [in] directory - выходной каталог (создается при необходимости)
+    * \return true - все файлы записаны, false - в противном случае
+    */
+    bool writeColumns(const QString& directory) const;
+};
+
+#endif // COVERAGEEXPORTER_H
@@ -0,0 +1,232 @@
+/*!
+* \file
+* \brief Файл содержит стратегии хранения дерева, множеств результата и обхода для шаблона CoverageEngine.
+*/
+
+#ifndef COVERAGEPOLICIES_H
+#define COVERAGEPOLICIES_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QVector>
+#include "node.h"
+
+/*!
+* \brief Нумерует узлы, достижимые из начальных узлов, в порядке обхода в глубину
+* \param [in] startNodes - начальные узлы
+* \param [out] nodes - узлы в порядке номеров
+* \param [out] indices - таблица узел - номер
+*/
+inline void collectReachableNodes(const QList<Node*>& startNodes, QList<Node*>& nodes, QHash<Node*, int>& indices) {
+    QList<Node*> stack;
+    for (Node* start : startNodes) {
+        if (start) {
+            stack.append(start);
+        }
+    }
+    while (!stack.isEmpty()) {
+        Node* node = stack.takeLast();
+        if (indices.contains(node)) {
+            continue;
+        }
+        indices.insert(node, nodes.size());
+        nodes.append(node);
+        for (int i = node->children.size() - 1; i >= 0; --i) {
+            stack.append(node->children[i]);
+        }
+    }
+}
+
+/*!
+* \brief Стратегия хранения дерева: исходные узлы Node с таблицей номеров, дети берутся из Node::children
+*/
+class PointerTreePolicy
+{
+public:
+    QList<Node*> nodes; //!< узлы в порядке номеров
+    QHash<Node*, int> indices; //!< таблица узел - номер
+
+    /*!
+    * \brief Нумерует узлы, достижимые из начальных узлов
+    * \param [in] startNodes - начальные узлы
+    */
+    void build(const QList<Node*>& startNodes) {
+        nodes.clear();
+        indices.clear();
+        collectReachableNodes(startNodes, nodes, indices);
+    }
+
+    int size() const { return nodes.size(); }
+    Node::Shape shape(int node) const { return nodes[node]->shape; }
+    int childCount(int node) const { return nodes[node]->children.size(); }
+    int child(int node, int position) const { return indices.value(nodes[node]->children[position]); }
+};
+
+/*!
+* \brief Стратегия хранения дерева: плоские массивы форм и детей (списки детей подряд, смещения начала списка каждого узла)
+*/
+class FlatTreePolicy
+{
+public:
+    QList<Node*> nodes; //!< узлы в порядке номеров
+    QHash<Node*, int> indices; //!< таблица узел - номер
+    QVector<qint8> shapes; //!< формы узлов
+    QVector<int> childOffsets; //!< смещение списка детей узла, последний элемент равен количеству ребер
+    QVector<int> childIndices; //!< номера детей всех узлов подряд
+
+    /*!
+    * \brief Нумерует узлы, достижимые из начальных узлов, и раскладывает дерево в массивы
+    * \param [in] startNodes - начальные узлы
+    */
+    void build(const QList<Node*>& startNodes) {
+        nodes.clear();
+        indices.clear();
+        collectReachableNodes(startNodes, nodes, indices);
+        shapes.resize(nodes.size());
+        childOffsets.resize(nodes.size() + 1);
+        childIndices.clear();
+        for (int i = 0; i < nodes.size(); ++i) {
+            shapes[i] = static_cast<qint8>(nodes[i]->shape);
+            childOffsets[i] = childIndices.size();
+            for (Node* child : nodes[i]->children) {
+                childIndices.append(indices.value(child));
+            }
+        }
+        childOffsets[nodes.size()] = childIndices.size();
+    }
+
+    int size() const { return nodes.size(); }
+    Node::Shape shape(int node) const { return static_cast<Node::Shape>(shapes[node]); }
+    int childCount(int node) const { return childOffsets[node + 1] - childOffsets[node]; }
+    int child(int node, int position) const { return childIndices[childOffsets[node] + position]; }
+};
+
+/*!
+* \brief Стратегия множества результата на основе QSet номеров узлов
+*/
+class HashSetPolicy
+{
+public:
+    QSet<int> items; //!< номера узлов множества
+
+    void reset(int) { items.clear(); }
+    void insert(int node) { items.insert(node); }
+    void remove(int node) { items.remove(node); }
+    bool contains(int node) const { return items.contains(node); }
+    QList<int> values() const { return QList<int>(items.begin(), items.end()); }
+};
+
+/*!
+* \brief Стратегия множества результата на основе битового массива по номерам узлов
+*/
+class BitSetPolicy
+{
+public:
+    QBitArray bits; //!< признак принадлежности узла множеству
+
+    void reset(int size) { bits = QBitArray(size); }
+    void insert(int node) { bits.setBit(node); }
+    void remove(int node) { bits.clearBit(node); }
+    bool contains(int node) const { return bits.testBit(node); }
+    QList<int> values() const {
+        QList<int> result;
+        for (int i = 0; i < bits.size(); ++i) {
+            if (bits.testBit(i)) {
+                result.append(i);
+            }
+        }
+        return result;
+    }
+};
+
+/*!
+* \brief Стратегия обхода рекурсией: глубина дерева ограничена стеком потока
+*/
+class RecursiveTraversal
+{
+public:
+    /*!
+    * \brief Обходит поддерево, начиная с подготовленного кадра
+    * \param [in,out] engine - анализатор, задающий действия при входе в узел, возврате из ребенка и выходе из узла
+    * \param [in] frame - кадр начального узла
+    * \return статус покрытия начального узла
+    */
+    template <typename Engine>
+    static typename Engine::Status run(Engine& engine, typename Engine::Frame frame) {
+        engine.enter(frame);
+        for (int position = 0; position < frame.childCount; ++position) {
+            typename Engine::Frame childFrame = engine.childFrame(frame, engine.tree.child(frame.node, position));
+            const typename Engine::Status childStatus = run(engine, childFrame);
+            engine.childDone(frame, childFrame.node, childStatus);
+        }
+        return engine.exit(frame);
+    }
+};
+
+/*!
+* \brief Стратегия обхода явным стеком кадров: глубина дерева ограничена только памятью
+*/
+class IterativeTraversal
+{
+public:
+    /*!
+    * \brief Обходит поддерево, начиная с подготовленного кадра
+    * \param [in,out] engine - анализатор, задающий действия при входе в узел, возврате из ребенка и выходе из узла
+    * \param [in] frame - кадр начального узла
+    * \return статус покрытия начального узла
+    */
+    template <typename Engine>
+    static typename Engine::Status run(Engine& engine, typename Engine::Frame frame) {
+        QVector<typename Engine::Frame> stack;
+        engine.enter(frame);
+        stack.append(frame);
+        typename Engine::Status status = Engine::Status();
+        while (!stack.isEmpty()) {
+            typename Engine::Frame& top = stack.last();
+            if (top.nextChild < top.childCount) {
+                typename Engine::Frame childFrame = engine.childFrame(top, engine.tree.child(top.node, top.nextChild++));
+                engine.enter(childFrame);
+                stack.append(childFrame);
+            }
+            else {
+                const typename Engine::Frame finished = stack.takeLast();
+                status = engine.exit(finished);
+                if (!stack.isEmpty()) {
+                    engine.childDone(stack.last(), finished.node, status);
+                }
+            }
+        }
+        return status;
+    }
+};
+
+/*!
+* \brief Стратегия действий при обходе, ничего не добавляющая к правилам зон
+*/
+class NoCoverageHooks
+{
+public:
+    /*!
+    * \brief Вызывается при входе в узел каждой зоны
+    * \return false - если обход узла нужно прервать
+    */
+    template <typename Engine>
+    bool visit(Engine&, int, typename Engine::Zone) { return true; }
+
+    /*!
+    * \brief Предлагает статус поддерева в зоне недостающих узлов без его обхода
+    * \return true - если статус задан и поддерево не обходится
+    */
+    template <typename Engine>
+    bool reuse(Engine&, int, typename Engine::Status&) { return false; }
+
+    /*!
+    * \brief Вызывается при выходе из узла с зоной, в которой он анализировался, и статусом (в зоне недостающих узлов)
+    */
+    template <typename Engine>
+    void leave(Engine&, int, typename Engine::Zone, typename Engine::Status) {}
+};
+
+#endif // COVERAGEPOLICIES_H
@@ -0,0 +1,42 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса CoverageResult.
+*/
+
+#include "coverageresult.h"
+
+CoverageResult::CoverageResult()
+    : status(Covered) {}
+
+bool CoverageResult::isValid() const
+{
+    return status == Covered || status == NotCovered;
+}
+
+QDataStream& operator<<(QDataStream& out, const CoverageResult& result)
+{
+    out << static_cast<qint32>(result.status);
+    out << static_cast<qint32>(result.errors.size());
+    for (const Error& error : result.errors) {
+        out << static_cast<qint32>(error.type) << error.details;
+    }
+    out << result.targetNodes << result.extraNodes << result.missingNodes << result.redundantNodes << result.suggestedNodes;
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, CoverageResult& result)
+{
+    qint32 status = 0;
+    qint32 errorCount = 0;
+    in >> status >> errorCount;
+    result.status = static_cast<CoverageResult::Status>(status);
+    result.errors.clear();
+    for (qint32 i = 0; i < errorCount && in.status() == QDataStream::Ok; ++i) {
+        qint32 type = 0;
+        QString details;
+        in >> type >> details;
+        result.errors.append(Error(static_cast<Error::ErrorType>(type), details));
+    }
+    in >> result.targetNodes >> result.extraNodes >> result.missingNodes >> result.redundantNodes >> result.suggestedNodes;
+    return in;
+}
@@ -0,0 +1,70 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса CoverageResult с результатом анализа покрытия для встраивания в другие программы.
+*/
+
+#ifndef COVERAGERESULT_H
+#define COVERAGERESULT_H
+
+#include <QDataStream>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include "error.h"
+
+/*!
+* \brief Класс для хранения результата анализа покрытия, не зависящего от времени жизни анализатора и его узлов.
+*/
+class CoverageResult
+{
+public:
+    /*!
+    * \brief перечисление итогов анализа
+    */
+    enum Status {
+        Covered,
+        NotCovered,
+        ParseErrors,
+        GraphErrors,
+        Canceled,
+        LimitExceeded
+    };
+
+    /*!
+    * \brief Конструктор по умолчанию для класса CoverageResult
+    */
+    CoverageResult();
+
+    Status status; //!< итог анализа
+    QList<Error> errors; //!< найденные ошибки (без ссылок на узлы)
+    QStringList targetNodes; //!< имена целевых узлов
+    QStringList extraNodes; //!< имена лишних узлов
+    QStringList missingNodes; //!< имена узлов, которых не хватает для покрытия
+    QList<QPair<QString, QString>> redundantNodes; //!< пары имен: отмеченный предок - избыточный узел
+    QList<QPair<QString, int>> suggestedNodes; //!< предлагаемые для отметки узлы и количество листьев, которые они покроют
+
+    /*!
+    * \brief Проверяет, что анализ выполнен без ошибок во входных данных
+    * \return true - если статус Covered или NotCovered
+    */
+    bool isValid() const;
+};
+
+/*!
+* \brief Записывает результат анализа в двоичный поток (ошибки сохраняются без ссылок на узлы)
+* \param [out] out - поток
+* \param [in] result - результат анализа
+* \return поток
+*/
+QDataStream& operator<<(QDataStream& out, const CoverageResult& result);
+
+/*!
+* \brief Читает результат анализа из двоичного потока
+* \param [in] in - поток
+* \param [out] result - результат анализа
+* \return поток
+*/
+QDataStream& operator>>(QDataStream& in, CoverageResult& result);
+
+#endif // COVERAGERESULT_H
@@ -0,0 +1,97 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса CoverageWatcher.
+*/
+
+#include "coveragewatcher.h"
+#include <QFile>
+#include <QFileInfo>
+
+CoverageWatcher::CoverageWatcher()
+    : isValidationSkipped(false), analysisCount(0) {
+    debounceTimer.setSingleShot(true);
+}
+
+bool CoverageWatcher::start(const QString& fileName, int debounceMs) {
+    inputFile = fileName;
+    debounceTimer.setInterval(debounceMs);
+
+    // Редакторы часто сохраняют файл через замену, поэтому наблюдаем и за каталогом, чтобы вернуть файл на наблюдение
+    if (!watcher.addPath(inputFile)) {
+        return false;
+    }
+    watcher.addPath(QFileInfo(inputFile).absolutePath());
+    QObject::connect(&watcher, &QFileSystemWatcher::fileChanged, &debounceTimer, [this]() {
+        scheduleAnalysis();
+    });
+    QObject::connect(&watcher, &QFileSystemWatcher::directoryChanged, &debounceTimer, [this]() {
+        scheduleAnalysis();
+    });
+    QObject::connect(&debounceTimer, &QTimer::timeout, &debounceTimer, [this]() {
+        if (analyzeFile()) {
+            qDebug() << "Результат обновлен в:" << analyzer.resultFileName;
+        }
+    });
+
+    analyzeFile();
+    return true;
+}
+
+void CoverageWatcher::scheduleAnalysis() {
+    if (!watcher.files().contains(inputFile) && QFileInfo::exists(inputFile)) {
+        watcher.addPath(inputFile);
+    }
+    debounceTimer.start();
+}
+
+bool CoverageWatcher::analyzeFile() {
+    QFile file(inputFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        // Файл мог быть удален на время сохранения, ждем его появления в каталоге
+        return false;
+    }
+    const QString content = QString::fromUtf8(file.readAll());
+    file.close();
+
+    analyzeContent(content);
+    if (!analyzer.writeResultFile(analyzer.resultFileName)) {
+        qCritical() << "Ошибка при записи файла:" << analyzer.resultFileName;
+        return false;
+    }
+    return true;
+}
+
+void CoverageWatcher::analyzeContent(const QString& content) {
+    analysisCount++;
+    isValidationSkipped = false;
+
+    // 1. Разбор нужен всегда, так как изменились как минимум атрибуты узлов
+    analyzer.parseDOT(content);
+    if (!analyzer.errors.isEmpty()) {
+        return;
+    }
+
+    // 2. При неизменной структуре граф уже проверен, восстанавливаем только его корень
+    const QByteArray structure = analyzer.structureHash();
+    if (structure == validatedStructure) {
+        for (Node* node : analyzer.treeMap) {
+            if (node->name == validatedRootName) {
+                analyzer.rootNodes.insert(node);
+                break;
+            }
+        }
+        isValidationSkipped = true;
+    }
+    else {
+        validatedStructure.clear();
+        analyzer.fillHash(analyzer.treeMap, analyzer.amountOfParents);
+        if (!analyzer.errors.isEmpty()) {
+            return;
+        }
+        validatedStructure = structure;
+        validatedRootName = (*analyzer.rootNodes.begin())->name;
+    }
+
+    // 3. Анализ покрытия
+    analyzer.analyzeCoverage();
+}
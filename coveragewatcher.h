@@ -0,0 +1,65 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса CoverageWatcher, повторяющего анализ при изменении DOT-файла.
+*/
+
+#ifndef COVERAGEWATCHER_H
+#define COVERAGEWATCHER_H
+
+#include <QByteArray>
+#include <QFileSystemWatcher>
+#include <QString>
+#include <QTimer>
+#include "treecoverageanalyzer.h"
+
+/*!
+* \brief Класс режима наблюдения: анализатор живет все время работы, файл перечитывается после серии изменений.
+*
+* Изменения собираются таймером debounceMs, поэтому несколько сохранений подряд дают один анализ.
+* Если после разбора структура графа (имена узлов и ребра) не изменилась, проверка графа на дерево пропускается.
+*/
+class CoverageWatcher
+{
+public:
+    /*!
+    * \brief Конструктор по умолчанию для класса CoverageWatcher
+    */
+    CoverageWatcher();
+
+    QFileSystemWatcher watcher; //!< наблюдатель за файлом и его каталогом
+    QTimer debounceTimer; //!< таймер, откладывающий анализ до конца серии изменений
+    TreeCoverageAnalyzer analyzer; //!< анализатор, живущий между изменениями файла
+    QString inputFile; //!< наблюдаемый DOT-файл
+    QByteArray validatedStructure; //!< хэш структуры последнего дерева, прошедшего проверку
+    QString validatedRootName; //!< имя корня последнего дерева, прошедшего проверку
+    bool isValidationSkipped; //!< при последнем анализе проверка графа была пропущена
+    int analysisCount; //!< количество выполненных анализов
+
+    /*!
+    * \brief Выполняет первый анализ и начинает наблюдение за файлом
+    * \param [in] fileName - наблюдаемый DOT-файл
+    * \param [in] debounceMs - задержка анализа после последнего изменения в миллисекундах
+    * \return true - если файл удалось поставить на наблюдение, false - в противном случае
+    */
+    bool start(const QString& fileName, int debounceMs);
+
+    /*!
+    * \brief Откладывает анализ до окончания серии изменений и восстанавливает наблюдение после сохранения через замену файла
+    */
+    void scheduleAnalysis();
+
+    /*!
+    * \brief Перечитывает файл, анализирует его и перезаписывает результат
+    * \return true - если файл прочитан и результат записан, false - в противном случае
+    */
+    bool analyzeFile();
+
+    /*!
+    * \brief Анализирует новое содержимое файла, пропуская проверку графа, если изменились только атрибуты узлов
+    * \param [in] content - содержимое DOT-файла
+    * \param [out] isValidationSkipped - проверка графа была пропущена
+    */
+    void analyzeContent(const QString& content);
+};
+
+#endif // COVERAGEWATCHER_H
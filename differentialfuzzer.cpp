@@ -0,0 +1,239 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса DifferentialFuzzer.
+*/
+
+#include "differentialfuzzer.h"
+#include <QSet>
+#include "coverageengine.h"
+#include "dotgenerator.h"
+#include "sharedtree.h"
+
+/*!
+* \brief Анализирует контент вариантом CoverageEngine: проверка графа выполняется анализатором, обход – вариантом
+* \param [in] content - содержимое DOT-файла
+* \return результат анализа, упорядоченный так же, как у анализатора
+*/
+template <typename EngineType>
+static CoverageResult analyzeWithEngine(const QString& content) {
+    TreeCoverageAnalyzer analyzer;
+    CoverageResult::Status status;
+    if (!analyzer.validate(content, status)) {
+        return analyzer.buildResult(status);
+    }
+    Node* root = *analyzer.rootNodes.begin();
+    EngineType engine(QList<Node*>{root});
+    engine.analyzeZoneWithExtraNodes(root);
+    analyzer.extraNodes = engine.nodeSet(engine.extraNodes);
+    analyzer.missingNodes = engine.nodeSet(engine.missingNodes);
+    analyzer.redundantNodes = engine.redundantNodeSet();
+    const bool covered = analyzer.extraNodes.isEmpty() && analyzer.redundantNodes.isEmpty() && analyzer.missingNodes.isEmpty();
+    return analyzer.buildResult(covered ? CoverageResult::Covered : CoverageResult::NotCovered);
+}
+
+/*!
+* \brief Анализирует контент через общее дерево и запрос покрытия
+* \param [in] content - содержимое DOT-файла
+* \return результат анализа
+*/
+static CoverageResult analyzeWithSharedTree(const QString& content) {
+    CoverageResult failure;
+    const QSharedPointer<const SharedTree> tree = SharedTree::load(content, failure);
+    if (!tree) {
+        return failure;
+    }
+    return CoverageQuery(tree).analyze();
+}
+
+/*!
+* \brief Переводит ошибки в строку для сравнения и отчета
+*/
+static QString errorsText(const QList<Error>& errors) {
+    QStringList parts;
+    for (const Error& error : errors) {
+        parts.append(error.details.isEmpty() ? error.typeName() : error.typeName() + "(" + error.details + ")");
+    }
+    return parts.join(", ");
+}
+
+/*!
+* \brief Переводит пары избыточных узлов в строку для сравнения и отчета
+*/
+static QString pairsText(const QList<QPair<QString, QString>>& pairs) {
+    QStringList parts;
+    for (const QPair<QString, QString>& pair : pairs) {
+        parts.append(pair.first + "->" + pair.second);
+    }
+    return parts.join(", ");
+}
+
+/*!
+* \brief Сравнивает результат варианта с результатом эталона
+* \param [in] engine - имя варианта
+* \param [in] expected - результат эталона
+* \param [in] actual - результат варианта
+* \return расхождения по полям
+*/
+static QList<DifferentialFuzzer::Mismatch> compareResults(const QString& engine, const CoverageResult& expected, const CoverageResult& actual) {
+    const QList<QPair<QString, QPair<QString, QString>>> fields = {
+        qMakePair(QString("status"), qMakePair(QString::number(expected.status), QString::number(actual.status))),
+        qMakePair(QString("errors"), qMakePair(errorsText(expected.errors), errorsText(actual.errors))),
+        qMakePair(QString("extraNodes"), qMakePair(expected.extraNodes.join(", "), actual.extraNodes.join(", "))),
+        qMakePair(QString("missingNodes"), qMakePair(expected.missingNodes.join(", "), actual.missingNodes.join(", "))),
+        qMakePair(QString("redundantNodes"), qMakePair(pairsText(expected.redundantNodes), pairsText(actual.redundantNodes)))
+    };
+    QList<DifferentialFuzzer::Mismatch> mismatches;
+    for (const QPair<QString, QPair<QString, QString>>& field : fields) {
+        if (field.second.first != field.second.second) {
+            DifferentialFuzzer::Mismatch mismatch;
+            mismatch.engine = engine;
+            mismatch.field = field.first;
+            mismatch.expected = field.second.first;
+            mismatch.actual = field.second.second;
+            mismatches.append(mismatch);
+        }
+    }
+    return mismatches;
+}
+
+DifferentialFuzzer::DifferentialFuzzer() {
+    engines.append(qMakePair(QString("ReferenceCoverageEngine"), Engine(analyzeWithEngine<ReferenceCoverageEngine>)));
+    engines.append(qMakePair(QString("FastCoverageEngine"), Engine(analyzeWithEngine<FastCoverageEngine>)));
+    engines.append(qMakePair(QString("SharedTree"), Engine(analyzeWithSharedTree)));
+}
+
+CoverageResult DifferentialFuzzer::reference(const QString& content) {
+    TreeCoverageAnalyzer analyzer;
+    CoverageResult::Status status;
+    if (!analyzer.validate(content, status)) {
+        return analyzer.buildResult(status);
+    }
+    return analyzer.buildResult(analyzer.analyzeValidTree());
+}
+
+QString DifferentialFuzzer::generateInput(QRandomGenerator& random) {
+    // 1. Дерево случайной формы и размера, примерно в каждом четвертом входе – ошибка каждого вида
+    DotGenerator generator;
+    generator.shape = static_cast<DotGenerator::TreeShape>(random.bounded(4));
+    generator.size = 1 + static_cast<int>(random.bounded(40u));
+    generator.arity = 1 + static_cast<int>(random.bounded(4u));
+    generator.seed = random.generate();
+    generator.targetDensity = random.bounded(0.2);
+    generator.selectedDensity = random.bounded(0.5);
+    generator.cycleCount = random.bounded(4u) == 0 ? 1 : 0;
+    generator.multiParentCount = random.bounded(4u) == 0 ? 1 : 0;
+    generator.undirectedEdgeCount = random.bounded(8u) == 0 ? 1 : 0;
+    generator.nodeLabelCount = random.bounded(8u) == 0 ? 1 : 0;
+    generator.edgeLabelCount = random.bounded(8u) == 0 ? 1 : 0;
+    QStringList lines = generator.generate().split('\n');
+
+    // 2. Порча строк: удаление, повтор, замена формы узла
+    const int mutationCount = static_cast<int>(random.bounded(3u));
+    for (int i = 0; i < mutationCount && !lines.isEmpty(); ++i) {
+        const int line = static_cast<int>(random.bounded(static_cast<quint32>(lines.size())));
+        switch (random.bounded(4u)) {
+        case 0:
+            lines.removeAt(line);
+            break;
+        case 1:
+            lines.insert(line, lines[line]);
+            break;
+        case 2:
+            lines[line].replace("square", "diamond");
+            break;
+        default:
+            lines[line].replace("diamond", "circle");
+            break;
+        }
+    }
+    return lines.join('\n');
+}
+
+QList<DifferentialFuzzer::Mismatch> DifferentialFuzzer::compare(const QString& content) const {
+    const CoverageResult expected = reference(content);
+    QList<Mismatch> mismatches;
+    for (const QPair<QString, Engine>& engine : engines) {
+        mismatches.append(compareResults(engine.first, expected, engine.second(content)));
+    }
+    return mismatches;
+}
+
+QString DifferentialFuzzer::minimize(const QString& content, const QString& engine) const {
+    Engine analyze;
+    for (const QPair<QString, Engine>& candidate : engines) {
+        if (candidate.first == engine) {
+            analyze = candidate.second;
+        }
+    }
+    if (!analyze) {
+        return content;
+    }
+    auto isFailing = [&](const QStringList& lines) {
+        const QString text = lines.join('\n');
+        return !compareResults(engine, reference(text), analyze(text)).isEmpty();
+    };
+
+    // Удаляются блоки строк, начиная с половины входа; блок уменьшается, когда ни один блок удалить нельзя
+    QStringList lines = content.split('\n');
+    int chunk = lines.size() / 2;
+    while (chunk >= 1) {
+        bool isRemoved = false;
+        for (int start = 0; start < lines.size(); ) {
+            QStringList candidate = lines;
+            candidate.remove(start, qMin(chunk, lines.size() - start));
+            if (isFailing(candidate)) {
+                lines = candidate;
+                isRemoved = true;
+            }
+            else {
+                start += chunk;
+            }
+        }
+        if (!isRemoved) {
+            chunk /= 2;
+        }
+        chunk = qMin(chunk, lines.size());
+    }
+    return lines.join('\n');
+}
+
+int DifferentialFuzzer::run(quint32 seed, int iterations, QTextStream& report) const {
+    QRandomGenerator random(seed);
+    int failedCount = 0;
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        const QString content = generateInput(random);
+        const QList<Mismatch> mismatches = compare(content);
+        if (mismatches.isEmpty()) {
+            continue;
+        }
+        failedCount++;
+
+        // Для каждого расходящегося варианта отчет содержит свой уменьшенный вход
+        QSet<QString> reportedEngines;
+        for (const Mismatch& mismatch : mismatches) {
+            if (reportedEngines.contains(mismatch.engine)) {
+                continue;
+            }
+            reportedEngines.insert(mismatch.engine);
+            const QString minimized = minimize(content, mismatch.engine);
+            QList<Mismatch> minimizedMismatches;
+            for (const Mismatch& candidate : compare(minimized)) {
+                if (candidate.engine == mismatch.engine) {
+                    minimizedMismatches.append(candidate);
+                }
+            }
+            report << "Итерация " << iteration << " (зерно " << seed << "):\n";
+            writeMismatches(minimized, minimizedMismatches, report);
+        }
+    }
+    report.flush();
+    return failedCount;
+}
+
+void DifferentialFuzzer::writeMismatches(const QString& content, const QList<Mismatch>& mismatches, QTextStream& report) {
+    for (const Mismatch& mismatch : mismatches) {
+        report << "  " << mismatch.engine << "." << mismatch.field << ": ожидалось [" << mismatch.expected
+               << "], получено [" << mismatch.actual << "]\n";
+    }
+    report << "  Вход:\n" << content << "\n\n";
+}
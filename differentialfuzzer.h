@@ -0,0 +1,99 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса DifferentialFuzzer, сравнивающего варианты анализа с эталонным TreeCoverageAnalyzer на случайных входах.
+*/
+
+#ifndef DIFFERENTIALFUZZER_H
+#define DIFFERENTIALFUZZER_H
+
+#include <functional>
+#include <QList>
+#include <QPair>
+#include <QRandomGenerator>
+#include <QString>
+#include <QTextStream>
+#include "coverageresult.h"
+
+/*!
+* \brief Класс дифференциального фаззинга: каждый вход анализируется эталоном и всеми зарегистрированными вариантами.
+*
+* Эталон – разбор, проверка и анализ покрытия методами TreeCoverageAnalyzer. Варианты получают тот же DOT-контент
+* и возвращают CoverageResult, сравниваются статус, ошибки, лишние, недостающие и избыточные узлы.
+* Входы создаются DotGenerator со случайными параметрами и затем портятся построчно, поэтому среди них есть и деревья,
+* и графы с ошибками. При расхождении вход уменьшается удалением строк, пока расхождение сохраняется.
+*/
+class DifferentialFuzzer
+{
+public:
+    /*!
+    * \brief Вариант анализа: по DOT-контенту возвращает результат
+    */
+    typedef std::function<CoverageResult(const QString&)> Engine;
+
+    /*!
+    * \brief Расхождение варианта с эталоном
+    */
+    class Mismatch
+    {
+    public:
+        QString engine; //!< имя варианта
+        QString field; //!< поле результата (status, errors, extraNodes, missingNodes, redundantNodes)
+        QString expected; //!< значение эталона
+        QString actual; //!< значение варианта
+    };
+
+    /*!
+    * \brief Конструктор, регистрирующий варианты ReferenceCoverageEngine, FastCoverageEngine и SharedTree
+    */
+    DifferentialFuzzer();
+
+    QList<QPair<QString, Engine>> engines; //!< имена и варианты анализа, сравниваемые с эталоном
+
+    /*!
+    * \brief Анализирует контент эталонной реализацией
+    * \param [in] content - содержимое DOT-файла
+    * \return результат анализа
+    */
+    static CoverageResult reference(const QString& content);
+
+    /*!
+    * \brief Создает случайный вход: дерево DotGenerator, возможно испорченное
+    * \param [in,out] random - генератор случайных чисел
+    * \return содержимое DOT-файла
+    */
+    static QString generateInput(QRandomGenerator& random);
+
+    /*!
+    * \brief Сравнивает результаты всех вариантов с эталоном
+    * \param [in] content - содержимое DOT-файла
+    * \return найденные расхождения
+    */
+    QList<Mismatch> compare(const QString& content) const;
+
+    /*!
+    * \brief Уменьшает вход удалением строк, сохраняя расхождение заданного варианта
+    * \param [in] content - вход с расхождением
+    * \param [in] engine - имя варианта
+    * \return наименьший найденный вход, на котором вариант расходится с эталоном
+    */
+    QString minimize(const QString& content, const QString& engine) const;
+
+    /*!
+    * \brief Выполняет заданное количество итераций с генератором, заданным зерном, и записывает уменьшенные контрпримеры
+    * \param [in] seed - зерно генератора случайных чисел
+    * \param [in] iterations - количество входов
+    * \param [out] report - поток для отчета о расхождениях
+    * \return количество входов с расхождениями
+    */
+    int run(quint32 seed, int iterations, QTextStream& report) const;
+
+    /*!
+    * \brief Записывает расхождения и вход в отчет
+    * \param [in] content - вход
+    * \param [in] mismatches - расхождения
+    * \param [out] report - поток для отчета
+    */
+    static void writeMismatches(const QString& content, const QList<Mismatch>& mismatches, QTextStream& report);
+};
+
+#endif // DIFFERENTIALFUZZER_H
@@ -0,0 +1,178 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса DotGenerator.
+*/
+
+#include "dotgenerator.h"
+#include <QSet>
+#include <QVector>
+
+/*!
+* \brief Выбирает различные номера из отрезка [first, last)
+* \param [in,out] random - генератор случайных чисел
+* \param [in] count - количество номеров (ограничивается длиной отрезка)
+* \param [in] first - начало отрезка
+* \param [in] last - конец отрезка
+* \return выбранные номера
+*/
+static QSet<int> pickDistinct(QRandomGenerator& random, int count, int first, int last) {
+    QSet<int> picked;
+    const int available = qMax(0, last - first);
+    while (picked.size() < qMin(count, available)) {
+        picked.insert(first + static_cast<int>(random.bounded(static_cast<quint32>(available))));
+    }
+    return picked;
+}
+
+DotGenerator::DotGenerator()
+    : shape(RandomTree), size(1000), arity(2), seed(1), targetDensity(0.0), selectedDensity(0.0),
+      cycleCount(0), multiParentCount(0), undirectedEdgeCount(0), nodeLabelCount(0), edgeLabelCount(0) {}
+
+QList<int> DotGenerator::parents(QRandomGenerator& random) const {
+    QList<int> result;
+    result.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        if (i == 0) {
+            result.append(-1);
+            continue;
+        }
+        switch (shape) {
+        case ChainTree:
+            result.append(i - 1);
+            break;
+        case StarTree:
+            result.append(0);
+            break;
+        case BalancedTree:
+            result.append((i - 1) / qMax(1, arity));
+            break;
+        case RandomTree:
+            // Случайное рекурсивное дерево: родитель выбирается среди уже созданных узлов
+            result.append(static_cast<int>(random.bounded(static_cast<quint32>(i))));
+            break;
+        }
+    }
+    return result;
+}
+
+void DotGenerator::write(QTextStream& out) const {
+    // Все случайные решения принимаются в одном порядке, поэтому вывод зависит только от параметров и зерна
+    QRandomGenerator random(seed);
+    const QList<int> parentOf = parents(random);
+
+    // 1. Формы узлов
+    QVector<char> shapes(size, 'b');
+    for (int i = 0; i < size; ++i) {
+        const double value = random.generateDouble();
+        if (i == 1 || (size == 1 && i == 0) || value < targetDensity) {
+            shapes[i] = 't';
+        }
+        else if (value < targetDensity + selectedDensity) {
+            shapes[i] = 's';
+        }
+    }
+    const QSet<int> labeledNodes = pickDistinct(random, nodeLabelCount, 0, size);
+    const QSet<int> labeledEdges = pickDistinct(random, edgeLabelCount, 1, size);
+
+    out << "digraph generated {\n";
+
+    // 2. Объявления узлов с атрибутами, остальные узлы появляются в ребрах
+    for (int i = 0; i < size; ++i) {
+        const bool isLabeled = labeledNodes.contains(i);
+        if (shapes[i] == 'b' && !isLabeled) {
+            continue;
+        }
+        out << 'n' << i << '[';
+        if (shapes[i] != 'b') {
+            out << "shape=" << (shapes[i] == 't' ? "square" : "diamond");
+        }
+        if (isLabeled) {
+            out << (shapes[i] != 'b' ? ", " : "") << "label=\"n" << i << '"';
+        }
+        out << "];\n";
+    }
+
+    // 3. Ребра дерева
+    for (int i = 1; i < size; ++i) {
+        out << 'n' << parentOf[i] << "->n" << i;
+        if (labeledEdges.contains(i)) {
+            out << "[label=\"e" << i << "\"]";
+        }
+        out << ";\n";
+    }
+
+    // 4. Цикл: ребро от узла к одному из его ближайших предков, кроме корня, иначе у графа не осталось бы корня
+    //    и проверка начиналась бы с произвольного узла. Поэтому узел выбирается среди узлов, родитель которых не корень,
+    //    а если таких нет (звезда), цикл образует петля на узле
+    QList<int> cycleNodes;
+    for (int i = 1; i < size && cycleCount > 0; ++i) {
+        if (parentOf[i] > 0) {
+            cycleNodes.append(i);
+        }
+    }
+    for (int i = 0; i < cycleCount && size > 1; ++i) {
+        if (cycleNodes.isEmpty()) {
+            const int node = 1 + static_cast<int>(random.bounded(static_cast<quint32>(size - 1)));
+            out << 'n' << node << "->n" << node << ";\n";
+            continue;
+        }
+        const int node = cycleNodes[static_cast<int>(random.bounded(static_cast<quint32>(cycleNodes.size())))];
+        int ancestor = parentOf[node];
+        const int steps = static_cast<int>(random.bounded(8u));
+        for (int step = 0; step < steps && parentOf[ancestor] > 0; ++step) {
+            ancestor = parentOf[ancestor];
+        }
+        out << 'n' << node << "->n" << ancestor << ";\n";
+    }
+
+    // 5. Второй родитель: узел с меньшим номером не может быть потомком, поэтому цикл не возникает
+    for (int i = 0; i < multiParentCount && size > 2; ++i) {
+        const int node = 2 + static_cast<int>(random.bounded(static_cast<quint32>(size - 2)));
+        int parent = static_cast<int>(random.bounded(static_cast<quint32>(node - 1)));
+        if (parent >= parentOf[node]) {
+            parent++;
+        }
+        out << 'n' << parent << "->n" << node << ";\n";
+    }
+
+    // 6. Ненаправленные ребра
+    for (int i = 0; i < undirectedEdgeCount && size > 1; ++i) {
+        const int first = static_cast<int>(random.bounded(static_cast<quint32>(size)));
+        const int second = (first + 1 + static_cast<int>(random.bounded(static_cast<quint32>(size - 1)))) % size;
+        out << 'n' << first << "--n" << second << ";\n";
+    }
+    out << "}\n";
+}
+
+QString DotGenerator::generate() const {
+    QString content;
+    QTextStream out(&content);
+    write(out);
+    out.flush();
+    return content;
+}
+
+bool DotGenerator::parseShape(const QString& name, TreeShape& treeShape) {
+    const QString lowerName = name.toLower();
+    for (TreeShape candidate : {ChainTree, StarTree, BalancedTree, RandomTree}) {
+        if (shapeName(candidate) == lowerName) {
+            treeShape = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+QString DotGenerator::shapeName(TreeShape treeShape) {
+    switch (treeShape) {
+    case ChainTree:
+        return "chain";
+    case StarTree:
+        return "star";
+    case BalancedTree:
+        return "balanced";
+    case RandomTree:
+        return "random";
+    }
+    return QString();
+}
@@ -0,0 +1,86 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса DotGenerator, создающего деревья в формате DOT для нагрузочных тестов.
+*/
+
+#ifndef DOTGENERATOR_H
+#define DOTGENERATOR_H
+
+#include <QList>
+#include <QRandomGenerator>
+#include <QString>
+#include <QTextStream>
+
+/*!
+* \brief Класс генератора DOT-деревьев заданного размера и формы.
+*
+* Узлы называются n0, n1, ..., корень - n0, родитель всегда имеет меньший номер, чем ребенок.
+* Узел n1 всегда целевой, остальные узлы становятся целевыми или отмеченными с заданной вероятностью.
+* При одинаковых параметрах и зерне вывод совпадает побайтно, поэтому замеры и фаззинг используют одни и те же входы.
+*/
+class DotGenerator
+{
+public:
+    /*!
+    * \brief перечисление форм генерируемых деревьев
+    */
+    enum TreeShape {
+        ChainTree,
+        StarTree,
+        BalancedTree,
+        RandomTree
+    };
+
+    /*!
+    * \brief Конструктор по умолчанию: случайное дерево из 1000 узлов без отметок и внесенных ошибок
+    */
+    DotGenerator();
+
+    TreeShape shape; //!< форма дерева
+    int size; //!< количество узлов
+    int arity; //!< количество детей у узлов сбалансированного дерева
+    quint32 seed; //!< зерно генератора случайных чисел
+    double targetDensity; //!< вероятность, что узел (кроме n1) целевой
+    double selectedDensity; //!< вероятность, что нецелевой узел отмечен
+    int cycleCount; //!< количество ребер от узла к его предку (кроме корня), образующих цикл
+    int multiParentCount; //!< количество дополнительных ребер, дающих узлу второго родителя
+    int undirectedEdgeCount; //!< количество ненаправленных ребер
+    int nodeLabelCount; //!< количество узлов с атрибутом label
+    int edgeLabelCount; //!< количество ребер с атрибутом label
+
+    /*!
+    * \brief Вычисляет родителя каждого узла
+    * \param [in,out] random - генератор случайных чисел
+    * \return список родителей по номеру узла (у корня -1)
+    */
+    QList<int> parents(QRandomGenerator& random) const;
+
+    /*!
+    * \brief Записывает дерево в поток без сборки всего текста в памяти
+    * \param [out] out - поток для записи
+    */
+    void write(QTextStream& out) const;
+
+    /*!
+    * \brief Создает дерево в виде строки
+    * \return содержимое DOT-файла
+    */
+    QString generate() const;
+
+    /*!
+    * \brief Переводит имя формы дерева (chain, star, balanced, random) в значение перечисления
+    * \param [in] name - имя формы
+    * \param [out] treeShape - форма дерева
+    * \return true - если имя известно, false - в противном случае
+    */
+    static bool parseShape(const QString& name, TreeShape& treeShape);
+
+    /*!
+    * \brief Возвращает имя формы дерева
+    * \param [in] treeShape - форма дерева
+    * \return имя формы
+    */
+    static QString shapeName(TreeShape treeShape);
+};
+
+#endif // DOTGENERATOR_H
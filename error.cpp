@@ -35,11 +35,42 @@ QString Error::errMessage() const
     case EdgeLabel:
         return details.isEmpty() ? "У связи между узлами есть метка." :
                    QString("У связи между узлами %1 есть метка, которая ухудшает читаемость графа, стоит убрать ее.").arg(details);
+    case LimitExceeded:
+        return details.isEmpty() ? "Превышено ограничение ресурсов, анализ остановлен." :
+                   QString("Превышено ограничение ресурсов: %1. Анализ остановлен.").arg(details);
     default:
         return "Неизвестная ошибка.";
     }
 }
 
+QString Error::typeName() const
+{
+    switch (type) {
+    case EmptyFile:
+        return "EmptyFile";
+    case NoTargetNode:
+        return "NoTargetNode";
+    case Cycle:
+        return "Cycle";
+    case DisconnectedGraph:
+        return "DisconnectedGraph";
+    case MultiParents:
+        return "MultiParents";
+    case InvalidNodeShape:
+        return "InvalidNodeShape";
+    case UndirectedEdge:
+        return "UndirectedEdge";
+    case ExtraLabel:
+        return "ExtraLabel";
+    case EdgeLabel:
+        return "EdgeLabel";
+    case LimitExceeded:
+        return "LimitExceeded";
+    default:
+        return "Unknown";
+    }
+}
+
 QDebug operator<<(QDebug debug, const Error& error) {
     debug << "Error(" << error.type << ", \"" << ")";
     return debug;
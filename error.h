@@ -27,7 +27,8 @@ public:
         InvalidNodeShape,
         UndirectedEdge,
         ExtraLabel,
-        EdgeLabel
+        EdgeLabel,
+        LimitExceeded
     };
 
     /*!
@@ -44,6 +45,11 @@ public:
     */
     QString errMessage() const;
 
+    /*!
+    * \brief Метод для получения имени типа ошибки для машиночитаемого вывода
+    */
+    QString typeName() const;
+
     /*!
     * \brief Перегрузка оператора равенства для Error
     */
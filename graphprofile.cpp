@@ -0,0 +1,234 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса GraphProfile.
+*/
+
+#include "graphprofile.h"
+#include <QFile>
+#include <QHash>
+#include <QtAlgorithms>
+#include <algorithm>
+
+/*!
+* \brief Записывает распределение в текстовом виде
+* \param [out] out - поток для записи
+* \param [in] histogram - количество значений по интервалам
+*/
+static void writeHistogramText(QTextStream& out, const QVector<qint64>& histogram) {
+    for (int i = 0; i < histogram.size(); ++i) {
+        if (histogram[i] > 0) {
+            out << "  " << GraphProfile::bucketName(i) << ": " << histogram[i] << "\n";
+        }
+    }
+}
+
+/*!
+* \brief Записывает распределение JSON-объектом подпись интервала - количество
+* \param [out] json - писатель JSON
+* \param [in] histogram - количество значений по интервалам
+*/
+static void writeHistogramJson(JsonStreamWriter& json, const QVector<qint64>& histogram) {
+    json.beginObject();
+    for (int i = 0; i < histogram.size(); ++i) {
+        if (histogram[i] > 0) {
+            json.key(GraphProfile::bucketName(i));
+            json.value(histogram[i]);
+        }
+    }
+    json.endObject();
+}
+
+GraphProfile::GraphProfile(const QList<Node*>& treeMap)
+    : nodeCount(treeMap.size()), edgeCount(0), rootCount(0), leafCount(0), targetCount(0), selectedCount(0),
+      maxDepth(0), meanDepth(0.0), maxFanOut(0), meanFanOut(0.0) {
+    // 1. Номера узлов, количество родителей, формы и распределение количества детей
+    QHash<Node*, int> indices;
+    indices.reserve(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        indices.insert(treeMap[i], i);
+    }
+    QVector<int> parentCounts(nodeCount, 0);
+    int parentNodeCount = 0;
+    for (Node* node : treeMap) {
+        const int fanOut = node->children.size();
+        edgeCount += fanOut;
+        maxFanOut = qMax(maxFanOut, fanOut);
+        if (fanOut == 0) {
+            leafCount++;
+        }
+        else {
+            parentNodeCount++;
+        }
+        const int fanOutBucket = bucket(fanOut);
+        if (fanOutHistogram.size() <= fanOutBucket) {
+            fanOutHistogram.resize(fanOutBucket + 1);
+        }
+        fanOutHistogram[fanOutBucket]++;
+        if (node->shape == Node::Target) {
+            targetCount++;
+        }
+        else if (node->shape == Node::Selected) {
+            selectedCount++;
+        }
+        for (Node* child : node->children) {
+            parentCounts[indices.value(child)]++;
+        }
+    }
+    meanFanOut = parentNodeCount > 0 ? static_cast<double>(edgeCount) / parentNodeCount : 0.0;
+
+    // 2. Обход в ширину от корней, затем от еще не найденных узлов (они есть, только если граф содержит цикл без корня)
+    QVector<int> depths(nodeCount, -1);
+    QVector<int> discoveredBy(nodeCount, -1);
+    QVector<int> order;
+    order.reserve(nodeCount);
+    auto traverseFrom = [&](int start) {
+        depths[start] = 0;
+        order.append(start);
+        for (int position = order.size() - 1; position < order.size(); ++position) {
+            const int current = order[position];
+            for (Node* child : treeMap[current]->children) {
+                const int childIndex = indices.value(child);
+                if (depths[childIndex] < 0) {
+                    depths[childIndex] = depths[current] + 1;
+                    discoveredBy[childIndex] = current;
+                    order.append(childIndex);
+                }
+            }
+        }
+    };
+    for (int i = 0; i < nodeCount; ++i) {
+        if (parentCounts[i] == 0) {
+            rootCount++;
+            traverseFrom(i);
+        }
+    }
+    for (int i = 0; i < nodeCount; ++i) {
+        if (depths[i] < 0) {
+            traverseFrom(i);
+        }
+    }
+
+    // 3. Распределение глубины
+    qint64 depthSum = 0;
+    for (int depth : depths) {
+        depthSum += depth;
+        maxDepth = qMax(maxDepth, depth);
+        const int depthBucket = bucket(depth);
+        if (depthHistogram.size() <= depthBucket) {
+            depthHistogram.resize(depthBucket + 1);
+        }
+        depthHistogram[depthBucket]++;
+    }
+    meanDepth = nodeCount > 0 ? static_cast<double>(depthSum) / nodeCount : 0.0;
+
+    // 4. Размеры поддеревьев в обратном порядке обхода: дети учитываются раньше родителя
+    QVector<int> subtreeSizes(nodeCount, 1);
+    for (int position = order.size() - 1; position >= 0; --position) {
+        const int node = order[position];
+        if (discoveredBy[node] >= 0) {
+            subtreeSizes[discoveredBy[node]] += subtreeSizes[node];
+        }
+    }
+    QVector<int> candidates;
+    for (int i = 0; i < nodeCount; ++i) {
+        if (discoveredBy[i] >= 0) {
+            candidates.append(i);
+        }
+    }
+    const int count = qMin(static_cast<int>(candidates.size()), LargestSubtreeCount);
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), [&](int first, int second) {
+        if (subtreeSizes[first] != subtreeSizes[second]) {
+            return subtreeSizes[first] > subtreeSizes[second];
+        }
+        return treeMap[first]->name < treeMap[second]->name;
+    });
+    for (int i = 0; i < count; ++i) {
+        largestSubtrees.append(qMakePair(treeMap[candidates[i]]->name, subtreeSizes[candidates[i]]));
+    }
+}
+
+int GraphProfile::bucket(qint64 value) {
+    return value <= 0 ? 0 : 64 - qCountLeadingZeroBits(static_cast<quint64>(value));
+}
+
+QString GraphProfile::bucketName(int bucket) {
+    if (bucket <= 1) {
+        return QString::number(bucket);
+    }
+    const qint64 first = qint64(1) << (bucket - 1);
+    return QString("%1-%2").arg(first).arg(2 * first - 1);
+}
+
+void GraphProfile::writeText(QTextStream& out) const {
+    out << "Профиль графа:\n";
+    out << "Узлов: " << nodeCount << ", ребер: " << edgeCount << ", корней: " << rootCount << ", листьев: " << leafCount << "\n";
+    out << "Целевых узлов: " << targetCount << ", отмеченных узлов: " << selectedCount << "\n";
+    out << "Глубина: наибольшая " << maxDepth << ", средняя " << QString::number(meanDepth, 'f', 2) << "\n";
+    out << "Количество детей: наибольшее " << maxFanOut << ", среднее у узлов с детьми " << QString::number(meanFanOut, 'f', 2) << "\n";
+    out << "Распределение глубины:\n";
+    writeHistogramText(out, depthHistogram);
+    out << "Распределение количества детей:\n";
+    writeHistogramText(out, fanOutHistogram);
+    out << "Наибольшие поддеревья:\n";
+    for (const QPair<QString, int>& subtree : largestSubtrees) {
+        out << "  " << subtree.first << ": " << subtree.second << "\n";
+    }
+}
+
+void GraphProfile::writeJson(JsonStreamWriter& json) const {
+    json.beginObject();
+    json.key("nodes");
+    json.value(nodeCount);
+    json.key("edges");
+    json.value(edgeCount);
+    json.key("roots");
+    json.value(rootCount);
+    json.key("leaves");
+    json.value(leafCount);
+    json.key("target_nodes");
+    json.value(targetCount);
+    json.key("selected_nodes");
+    json.value(selectedCount);
+    json.key("max_depth");
+    json.value(maxDepth);
+    json.key("mean_depth");
+    json.value(meanDepth);
+    json.key("max_fan_out");
+    json.value(maxFanOut);
+    json.key("mean_fan_out");
+    json.value(meanFanOut);
+    json.key("depth_histogram");
+    writeHistogramJson(json, depthHistogram);
+    json.key("fan_out_histogram");
+    writeHistogramJson(json, fanOutHistogram);
+    json.key("largest_subtrees");
+    json.beginArray();
+    for (const QPair<QString, int>& subtree : largestSubtrees) {
+        json.beginObject();
+        json.key("node");
+        json.value(subtree.first);
+        json.key("size");
+        json.value(subtree.second);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
+
+bool GraphProfile::write(const QString& fileName, TreeCoverageAnalyzer::ResultFormat format) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    if (format == TreeCoverageAnalyzer::JsonFormat) {
+        JsonStreamWriter json(out);
+        writeJson(json);
+        out << "\n";
+    }
+    else {
+        writeText(out);
+    }
+    out.flush();
+    return true;
+}
@@ -0,0 +1,88 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса GraphProfile, описывающего размер и форму разобранного графа.
+*/
+
+#ifndef GRAPHPROFILE_H
+#define GRAPHPROFILE_H
+
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QTextStream>
+#include <QVector>
+#include "jsonstreamwriter.h"
+#include "treecoverageanalyzer.h"
+
+/*!
+* \brief Класс профиля графа: количество узлов и ребер, распределения глубины и количества детей, наибольшие поддеревья.
+*
+* Профиль строится сразу после разбора без проверки графа и анализа покрытия, обходом в ширину без рекурсии,
+* поэтому его можно получить и для глубоких деревьев, и для графов с циклами или несколькими родителями.
+* Глубина узла – длина кратчайшего пути от корня, поддеревья считаются по ребрам, которыми узлы были найдены при обходе.
+* Распределения записываются по интервалам степеней двойки: 0, 1, 2-3, 4-7, ...
+*/
+class GraphProfile
+{
+public:
+    /*!
+    * \brief Количество наибольших поддеревьев в профиле
+    */
+    static constexpr int LargestSubtreeCount = 5;
+
+    /*!
+    * \brief Конструктор, строящий профиль по узлам графа
+    * \param [in] treeMap - все узлы разобранного графа
+    */
+    explicit GraphProfile(const QList<Node*>& treeMap);
+
+    int nodeCount; //!< количество узлов
+    int edgeCount; //!< количество ребер
+    int rootCount; //!< количество узлов без родителя
+    int leafCount; //!< количество узлов без детей
+    int targetCount; //!< количество целевых узлов
+    int selectedCount; //!< количество отмеченных узлов
+    int maxDepth; //!< наибольшая глубина
+    double meanDepth; //!< средняя глубина узла
+    int maxFanOut; //!< наибольшее количество детей
+    double meanFanOut; //!< среднее количество детей у узлов с детьми
+    QVector<qint64> depthHistogram; //!< количество узлов по интервалам глубины
+    QVector<qint64> fanOutHistogram; //!< количество узлов по интервалам количества детей
+    QList<QPair<QString, int>> largestSubtrees; //!< имена узлов (кроме корней) с наибольшими поддеревьями и размеры поддеревьев
+
+    /*!
+    * \brief Возвращает номер интервала распределения для значения
+    * \param [in] value - неотрицательное значение
+    * \return 0 для значения 0, иначе k, где 2^(k-1) <= value < 2^k
+    */
+    static int bucket(qint64 value);
+
+    /*!
+    * \brief Возвращает подпись интервала распределения
+    * \param [in] bucket - номер интервала
+    * \return подпись вида "0", "1", "2-3", "4-7"
+    */
+    static QString bucketName(int bucket);
+
+    /*!
+    * \brief Записывает профиль в текстовом виде
+    * \param [out] out - поток для записи
+    */
+    void writeText(QTextStream& out) const;
+
+    /*!
+    * \brief Записывает профиль в JSON-объект
+    * \param [out] json - писатель JSON, объект открывается и закрывается методом
+    */
+    void writeJson(JsonStreamWriter& json) const;
+
+    /*!
+    * \brief Записывает профиль в файл
+    * \param [in] fileName - имя файла
+    * \param [in] format - формат вывода
+    * \return true - если файл записан, false - если его не удалось открыть
+    */
+    bool write(const QString& fileName, TreeCoverageAnalyzer::ResultFormat format) const;
+};
+
+#endif // GRAPHPROFILE_H
@@ -0,0 +1,113 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса JsonStreamWriter.
+*/
+
+#include "jsonstreamwriter.h"
+
+JsonStreamWriter::JsonStreamWriter(QTextStream& stream)
+    : out(stream), isAfterKey(false) {}
+
+void JsonStreamWriter::beginObject() {
+    separate();
+    out << '{';
+    isFirstInScope.append(true);
+}
+
+void JsonStreamWriter::endObject() {
+    isFirstInScope.removeLast();
+    out << '}';
+}
+
+void JsonStreamWriter::beginArray() {
+    separate();
+    out << '[';
+    isFirstInScope.append(true);
+}
+
+void JsonStreamWriter::endArray() {
+    isFirstInScope.removeLast();
+    out << ']';
+}
+
+void JsonStreamWriter::key(const QString& name) {
+    separate();
+    writeString(name);
+    out << ':';
+    isAfterKey = true;
+}
+
+void JsonStreamWriter::value(const QString& text) {
+    separate();
+    writeString(text);
+}
+
+void JsonStreamWriter::value(const char* text) {
+    value(QString::fromUtf8(text));
+}
+
+void JsonStreamWriter::value(int number) {
+    separate();
+    out << number;
+}
+
+void JsonStreamWriter::value(qint64 number) {
+    separate();
+    out << number;
+}
+
+void JsonStreamWriter::value(double number) {
+    separate();
+    out << QString::number(number, 'g', 17);
+}
+
+void JsonStreamWriter::value(bool flag) {
+    separate();
+    out << (flag ? "true" : "false");
+}
+
+void JsonStreamWriter::separate() {
+    // Значение после ключа идет без запятой
+    if (isAfterKey) {
+        isAfterKey = false;
+        return;
+    }
+    if (isFirstInScope.isEmpty()) {
+        return;
+    }
+    if (!isFirstInScope.last()) {
+        out << ',';
+    }
+    isFirstInScope.last() = false;
+}
+
+void JsonStreamWriter::writeString(const QString& text) {
+    out << '"';
+    for (QChar ch : text) {
+        switch (ch.unicode()) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\r':
+            out << "\\r";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (ch.unicode() < 0x20) {
+                out << QString("\\u%1").arg(ch.unicode(), 4, 16, QChar('0'));
+            }
+            else {
+                out << ch;
+            }
+        }
+    }
+    out << '"';
+}
@@ -0,0 +1,104 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса JsonStreamWriter для потоковой записи JSON.
+*/
+
+#ifndef JSONSTREAMWRITER_H
+#define JSONSTREAMWRITER_H
+
+#include <QList>
+#include <QString>
+#include <QTextStream>
+
+/*!
+* \brief Класс для записи JSON напрямую в поток без построения документа в памяти.
+*/
+class JsonStreamWriter
+{
+public:
+    /*!
+    * \brief Конструктор с передаваемым потоком для записи
+    * \param [in,out] stream - поток, в который записывается JSON
+    */
+    explicit JsonStreamWriter(QTextStream& stream);
+
+    /*!
+    * \brief Начинает объект
+    */
+    void beginObject();
+
+    /*!
+    * \brief Завершает объект
+    */
+    void endObject();
+
+    /*!
+    * \brief Начинает массив
+    */
+    void beginArray();
+
+    /*!
+    * \brief Завершает массив
+    */
+    void endArray();
+
+    /*!
+    * \brief Записывает ключ поля объекта, следующее значение относится к нему
+    * \param [in] name - имя поля
+    */
+    void key(const QString& name);
+
+    /*!
+    * \brief Записывает строковое значение
+    * \param [in] text - строка
+    */
+    void value(const QString& text);
+
+    /*!
+    * \brief Записывает строковое значение из литерала в UTF-8
+    * \param [in] text - строка
+    */
+    void value(const char* text);
+
+    /*!
+    * \brief Записывает целое значение
+    * \param [in] number - число
+    */
+    void value(int number);
+
+    /*!
+    * \brief Записывает целое значение
+    * \param [in] number - число
+    */
+    void value(qint64 number);
+
+    /*!
+    * \brief Записывает вещественное значение
+    * \param [in] number - число
+    */
+    void value(double number);
+
+    /*!
+    * \brief Записывает логическое значение
+    * \param [in] flag - значение
+    */
+    void value(bool flag);
+
+private:
+    QTextStream& out; //!< поток для записи
+    QList<bool> isFirstInScope; //!< для каждого открытого объекта или массива: не было ли в нем еще элементов
+    bool isAfterKey; //!< только что записан ключ, значение идет без разделителя
+
+    /*!
+    * \brief Записывает запятую перед очередным элементом, если он не первый
+    */
+    void separate();
+
+    /*!
+    * \brief Записывает строку в кавычках с экранированием
+    * \param [in] text - строка
+    */
+    void writeString(const QString& text);
+};
+
+#endif // JSONSTREAMWRITER_H
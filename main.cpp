@@ -14,16 +14,149 @@
 TreeCoverageAnalyzerApp.exe input.dot output.txt
 * \endcode
 
+Если в одном файле описано несколько независимых деревьев, используется режим леса:
+* \code
+TreeCoverageAnalyzerApp.exe --forest input.dot output.txt
+* \endcode
+
+Для повторного анализа новой ревизии дерева указывается снимок предыдущей ревизии, сохраненный параметром --save-state:
+хэши поддеревьев, статусы покрытия и найденные узлы. Неизменные поддеревья берут результаты из снимка без обхода,
+а предыдущая ревизия не разбирается заново (если вместо снимка указан DOT-файл, он разбирается и анализируется).
+Отчет о различиях записывается в diff_result.txt рядом с выходным файлом или в файл --diff-output:
+* \code
+TreeCoverageAnalyzerApp.exe --save-state monday.state monday.dot output.txt
+TreeCoverageAnalyzerApp.exe --diff monday.state --save-state tuesday.state --diff-output diff.txt tuesday.dot output.txt
+* \endcode
+
+Чтобы узнать, какие k отметок дадут наибольший прирост покрытия, используется параметр --suggest:
+* \code
+TreeCoverageAnalyzerApp.exe --suggest 5 input.dot output.txt
+* \endcode
+
+Покрытие каждого узла можно выгрузить потоком CSV или двоичными столбцами для внешних инструментов:
+* \code
+TreeCoverageAnalyzerApp.exe --export-csv nodes.csv --export-columns columns input.dot output.txt
+* \endcode
+
+Для машинной обработки результат можно записать в формате JSON с детерминированным порядком узлов:
+* \code
+TreeCoverageAnalyzerApp.exe --format json input.dot output.json
+* \endcode
+
+Для обработки множества файлов одним процессом используется пакетный режим: входом служит каталог с файлами *.dot
+или файл-список, выходом - каталог для результатов каждого файла и итоговой таблицы summary.csv:
+* \code
+TreeCoverageAnalyzerApp.exe --batch --threads 8 inputs results
+* \endcode
+
+На сетевых дисках параметр --pipeline перекрывает чтение следующих файлов разбором и анализом уже прочитанных:
+* \code
+TreeCoverageAnalyzerApp.exe --batch --pipeline --threads 8 inputs results
+* \endcode
+
+Для частых запросов к одним и тем же деревьям программа запускается резидентно и отвечает через локальный сокет
+на команды LOAD <путь>, SELECT <узлы через запятую> и RESULT [text|json], разобранные деревья остаются в памяти:
+* \code
+TreeCoverageAnalyzerApp.exe --daemon /tmp/coverage.sock
+* \endcode
+
+В пакетном и резидентном режимах повторяющиеся пары (дерево, отметки) могут браться из кэша результатов,
+который при указании каталога сохраняется между запусками:
+* \code
+TreeCoverageAnalyzerApp.exe --daemon /tmp/coverage.sock --cache 4096 --cache-dir cache
+* \endcode
+
+Для подробного разбора параметр --trace записывает проходы разбора, проверку каждого корня, обход зон покрытия
+и, в пакетном режиме, файлы на каждом потоке пула в формате Chrome trace-event для просмотра в chrome://tracing или Perfetto:
+* \code
+TreeCoverageAnalyzerApp.exe --batch --threads 8 --trace trace.json inputs results
+* \endcode
+Обход зон записывается одним отрезком с количеством посещенных узлов каждой зоны; параметр --trace-zones добавляет
+отрезок для каждой зоны недостающих и избыточных узлов.
+
+Чтобы найти медленную стадию, параметр --stats записывает время чтения, разбора, проверки, анализа и записи результата,
+пиковую память и размер дерева одной строкой JSON в поток ошибок или, с --stats-file, в конец файла:
+* \code
+TreeCoverageAnalyzerApp.exe --stats-file stats.jsonl input.dot output.txt
+* \endcode
+
+В статистику входит количество посещений узлов каждой функцией обхода. Если функция посетила узлы больше
+--visit-warning-factor раз на узел (по умолчанию 4), строка статистики и поток ошибок получают предупреждение:
+* \code
+TreeCoverageAnalyzerApp.exe --stats --visit-warning-factor 2 input.dot output.txt
+* \endcode
+
+Профиль графа показывает заранее, нагрузит ли файл глубину рекурсии или количество детей: без анализа покрытия
+в выходной файл записываются количество узлов и ребер, распределения глубины и количества детей и наибольшие поддеревья:
+* \code
+TreeCoverageAnalyzerApp.exe --profile --format json input.dot profile.json
+* \endcode
+
+Ограничения ресурсов защищают общий обработчик от слишком больших или зацикленных файлов: при превышении разбор,
+проверка или анализ останавливаются и в отчет об ошибках записывается ошибка LimitExceeded. В пакетном режиме
+и режиме наблюдения ограничения действуют для каждого файла, в резидентном - для загрузки и каждого запроса RESULT.
+Память оценивается по тексту, узлам и ребрам файла, поэтому параллельно анализируемые файлы друг другу не мешают:
+* \code
+TreeCoverageAnalyzerApp.exe --max-nodes 1000000 --max-depth 10000 --max-time-ms 5000 --max-memory-mb 2048 input.dot output.txt
+* \endcode
+
+В режиме наблюдения результат перезаписывается после каждого сохранения входного файла:
+* \code
+TreeCoverageAnalyzerApp.exe --watch --debounce 200 input.dot output.txt
+* \endcode
+
+Замеры производительности собираются отдельной программой из benchmarks/benchmarks.pro. Деревья больше 1e5 узлов
+замеряются только при заданной переменной окружения TREECOVERAGE_BENCHMARK_MAX_SIZE:
+* \code
+set TREECOVERAGE_BENCHMARK_MAX_SIZE=10000000
+BenchmarkApp.exe parseDOT_benchmark
+* \endcode
+
+Результаты замеров сохраняются базовой линией и сравниваются с ней: при росте времени больше --threshold процентов
+или количества выделений больше --allocation-threshold процентов программа завершается с кодом 1:
+* \code
+BenchmarkApp.exe --save-baseline baseline.json
+BenchmarkApp.exe --compare-baseline baseline.json --threshold 15
+* \endcode
+
+Сборка с подсчетом выделений памяти добавляет в строку --stats количество выделений, освобождений и байт по стадиям,
+а в замеры – строки _allocations и _allocated_bytes для каждого дерева. Поле allocation_source показывает, что считается:
+malloc – вся куча (Linux с glibc), operator new – только объекты, создаваемые через new (остальные платформы):
+* \code
+qmake "CONFIG+=allocation_profiler" benchmarks/benchmarks.pro
+* \endcode
+
+Деревья для нагрузочных тестов создаются программой tools/dotgenerator, вывод при одинаковом зерне совпадает:
+* \code
+DotGenerator.exe --shape random --size 1000000 --selected 0.1 --seed 7 tree.dot
+* \endcode
+
+Программа tools/fuzzer сравнивает варианты анализа (CoverageEngine, SharedTree) с TreeCoverageAnalyzer на случайных
+деревьях и графах с ошибками и выводит уменьшенные контрпримеры; с CONFIG+=libfuzzer входы подбирает libFuzzer:
+* \code
+DifferentialFuzzer.exe --seed 7 --iterations 100000
+* \endcode
+
 * \author Лубошников Иван
 * \date 27 Июня 2025
 * \version 1.1
 */
 
 #include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QTextStream>
 #include <QDebug>
 #include "treecoverageanalyzer.h"
+#include "coverageexporter.h"
+#include "batchanalyzer.h"
+#include "coveragedaemon.h"
+#include "coveragewatcher.h"
+#include "graphprofile.h"
+#include "runstatistics.h"
+#include "tracerecorder.h"
 #include "tests.h"
 #include <clocale>
 
@@ -33,16 +166,35 @@ int runTests() {
     return 0;
 }
 
+/*!
+ * \brief Считывает содержимое DOT-файла
+ * \param [in] fileName - путь к файлу
+ * \param [out] content - содержимое файла
+ * \return true - файл прочитан, false - файл не удалось открыть
+ */
+bool readDotFile(const QString& fileName, QString& content) {
+    qDebug() << "Чтение файла:" << fileName;
+    QFile dotFile(fileName);
+    if (!dotFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCritical() << "Ошибка при открытии файла для чтения:" << fileName;
+        return false;
+    }
+    content = QString::fromUtf8(dotFile.readAll());
+    dotFile.close();
+    return true;
+}
+
 /*!
  * \brief Главная функция программы TreeCoverageAnalyzerApp
  * \param [in] argc - количество переданных аргументов командной строки
  * \param [in] argv - переданные аргументы командной строки
  * \param [in] argv[0] - аргумент запуска программы
  * \param [in] argv[1] - путь к входному DOT-файлу
- * \param [in] argv[2] - путь к выходному текстовому файлу с результатами (игнорируется, результат записывается в coverage_result.txt)
+ * \param [in] argv[2] - путь к выходному текстовому файлу с результатами
  * \return 0 - программа завершилась успешно; 1 - была найдена ошибка
  */
 int main(int argc, char* argv[]) {
+    RunStatistics statistics; // Время запуска отсчитывается с самого начала, включая разбор аргументов
     if (argc == 1) {
         // Если аргументов нет - запускаем тесты
         return runTests();
@@ -53,48 +205,421 @@ int main(int argc, char* argv[]) {
     QCoreApplication app(argc, argv);
 
     // 1. Проверка аргументов командной строки
-    if (argc != 3) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Анализ покрытия узла дерева, описанного на языке DOT.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("input", "Входной DOT-файл.");
+    parser.addPositionalArgument("output", "Выходной файл с результатами.");
+    QCommandLineOption forestOption("forest", "Режим леса: каждая компонента связности анализируется как отдельное дерево.");
+    parser.addOption(forestOption);
+    QCommandLineOption diffOption("diff", "Сравнить с предыдущей ревизией дерева (снимок --save-state или DOT-файл) и пересчитать покрытие только для изменившихся поддеревьев.", "previous.state");
+    parser.addOption(diffOption);
+    QCommandLineOption saveStateOption("save-state", "Сохранить хэши поддеревьев и результаты анализа в снимок для следующего запуска с --diff.", "current.state");
+    parser.addOption(saveStateOption);
+    QCommandLineOption diffOutputOption("diff-output", "Файл отчета о различиях ревизий (по умолчанию diff_result.txt рядом с выходным файлом).", "diff.txt");
+    parser.addOption(diffOutputOption);
+    QCommandLineOption suggestOption("suggest", "Предложить k недостающих узлов, отметка которых даст наибольший прирост покрытия.", "k");
+    parser.addOption(suggestOption);
+    QCommandLineOption exportCsvOption("export-csv", "Выгрузить покрытие каждого узла в CSV-файл.", "nodes.csv");
+    parser.addOption(exportCsvOption);
+    QCommandLineOption exportColumnsOption("export-columns", "Выгрузить покрытие каждого узла двоичными столбцами в каталог.", "directory");
+    parser.addOption(exportColumnsOption);
+    QCommandLineOption profileOption("profile", "Записать в выходной файл профиль графа (размер, распределения глубины и количества детей, наибольшие поддеревья) без анализа покрытия.");
+    parser.addOption(profileOption);
+    QCommandLineOption formatOption("format", "Формат выходного файла: text или json.", "format", "text");
+    parser.addOption(formatOption);
+    QCommandLineOption batchOption("batch", "Пакетный режим: input - каталог с файлами *.dot или файл-список, output - каталог для результатов.");
+    parser.addOption(batchOption);
+    QCommandLineOption threadsOption("threads", "Количество потоков пакетного режима (по умолчанию - по числу ядер).", "n");
+    parser.addOption(threadsOption);
+    QCommandLineOption pipelineOption("pipeline", "Пакетный режим конвейером: чтение файлов, разбор и анализ выполняются параллельными стадиями.");
+    parser.addOption(pipelineOption);
+    QCommandLineOption daemonOption("daemon", "Резидентный режим: отвечать на запросы LOAD, SELECT и RESULT через локальный сокет.", "socket");
+    parser.addOption(daemonOption);
+    QCommandLineOption watchOption("watch", "Режим наблюдения: повторять анализ и перезаписывать результат при изменении входного файла.");
+    parser.addOption(watchOption);
+    QCommandLineOption debounceOption("debounce", "Задержка анализа после последнего изменения файла в режиме наблюдения.", "ms", "200");
+    parser.addOption(debounceOption);
+    QCommandLineOption cacheOption("cache", "Запоминать до n результатов для повторяющихся пар (дерево, отметки) в пакетном и резидентном режимах.", "n");
+    parser.addOption(cacheOption);
+    QCommandLineOption cacheDirOption("cache-dir", "Каталог для сохранения кэша результатов между запусками.", "directory");
+    parser.addOption(cacheDirOption);
+    QCommandLineOption statsOption("stats", "Записать время стадий, пиковую память и размер дерева строкой JSON в поток ошибок.");
+    parser.addOption(statsOption);
+    QCommandLineOption statsFileOption("stats-file", "Дописывать строку статистики в файл вместо потока ошибок.", "stats.jsonl");
+    parser.addOption(statsFileOption);
+    QCommandLineOption visitWarningOption("visit-warning-factor", "Предупреждать в статистике, если функция обхода посетила узлы больше k раз на узел (по умолчанию 4).", "k");
+    parser.addOption(visitWarningOption);
+    QCommandLineOption maxNodesOption("max-nodes", "Остановить анализ с ошибкой, если в графе больше n узлов.", "n");
+    parser.addOption(maxNodesOption);
+    QCommandLineOption maxEdgesOption("max-edges", "Остановить анализ с ошибкой, если в графе больше n ребер.", "n");
+    parser.addOption(maxEdgesOption);
+    QCommandLineOption maxDepthOption("max-depth", "Остановить анализ с ошибкой, если глубина узла больше n.", "n");
+    parser.addOption(maxDepthOption);
+    QCommandLineOption maxInputBytesOption("max-input-bytes", "Не анализировать входной файл больше n байт.", "n");
+    parser.addOption(maxInputBytesOption);
+    QCommandLineOption maxTimeOption("max-time-ms", "Остановить анализ с ошибкой, если разбор, проверка и анализ одного файла длятся дольше ms миллисекунд.", "ms");
+    parser.addOption(maxTimeOption);
+    QCommandLineOption maxMemoryOption("max-memory-mb", "Остановить анализ с ошибкой, если оценка памяти данных анализатора одного файла (текст, узлы, ребра) больше mb мегабайт.", "mb");
+    parser.addOption(maxMemoryOption);
+    QCommandLineOption traceOption("trace", "Записать трассировку проходов разбора, проверки, обхода зон и файлов пакета в формате Chrome trace-event.", "trace.json");
+    parser.addOption(traceOption);
+    QCommandLineOption traceZonesOption("trace-zones", "Записывать в трассировку отрезок каждой зоны недостающих и избыточных узлов.");
+    parser.addOption(traceZonesOption);
+    parser.process(app);
+
+    // Статистика запуска, если она запрошена
+    const bool isStatisticsEnabled = parser.isSet(statsOption) || parser.isSet(statsFileOption);
+
+    if (parser.isSet(visitWarningOption)) {
+        bool isNumber = false;
+        statistics.visitWarningFactor = parser.value(visitWarningOption).toDouble(&isNumber);
+        if (!isNumber || statistics.visitWarningFactor <= 0) {
+            qCritical() << "Ошибка: параметр --visit-warning-factor должен быть положительным числом";
+            return 1;
+        }
+    }
+
+    // Ограничения ресурсов, если они заданы
+    ResourceLimits resourceLimits;
+    const QList<QPair<QCommandLineOption*, qint64*>> limitOptions = {
+        qMakePair(&maxNodesOption, &resourceLimits.maxNodes),
+        qMakePair(&maxEdgesOption, &resourceLimits.maxEdges),
+        qMakePair(&maxDepthOption, &resourceLimits.maxDepth),
+        qMakePair(&maxInputBytesOption, &resourceLimits.maxInputBytes),
+        qMakePair(&maxTimeOption, &resourceLimits.maxTimeMs),
+        qMakePair(&maxMemoryOption, &resourceLimits.maxMemoryBytes)
+    };
+    for (const QPair<QCommandLineOption*, qint64*>& limitOption : limitOptions) {
+        if (parser.isSet(*limitOption.first)) {
+            bool isNumber = false;
+            *limitOption.second = parser.value(*limitOption.first).toLongLong(&isNumber);
+            if (!isNumber || *limitOption.second <= 0) {
+                qCritical() << "Ошибка: параметр --" + limitOption.first->names().first() + " должен быть положительным числом";
+                return 1;
+            }
+        }
+    }
+    resourceLimits.maxMemoryBytes *= 1024 * 1024;
+    const ResourceLimits* limits = resourceLimits.isEnabled() ? &resourceLimits : nullptr;
+
+    // Трассировка, если она запрошена
+    TraceRecorder traceRecorder;
+    TraceRecorder* trace = parser.isSet(traceOption) ? &traceRecorder : nullptr;
+    traceRecorder.isDetailed = parser.isSet(traceZonesOption);
+
+    auto writeReports = [&]() {
+        if (isStatisticsEnabled && !statistics.write(parser.value(statsFileOption))) {
+            qCritical() << "Ошибка при записи статистики в файл:" << parser.value(statsFileOption);
+            return false;
+        }
+        if (trace && !trace->write(parser.value(traceOption))) {
+            qCritical() << "Ошибка при записи трассировки в файл:" << parser.value(traceOption);
+            return false;
+        }
+        return true;
+    };
+
+    // Кэш результатов, если он запрошен
+    int cacheCapacity = 1024;
+    if (parser.isSet(cacheOption)) {
+        bool isNumber = false;
+        cacheCapacity = parser.value(cacheOption).toInt(&isNumber);
+        if (!isNumber || cacheCapacity <= 0) {
+            qCritical() << "Ошибка: параметр --cache должен быть положительным числом";
+            return 1;
+        }
+    }
+    ResultCache resultCache(cacheCapacity, parser.value(cacheDirOption));
+    ResultCache* sharedCache = parser.isSet(cacheOption) || parser.isSet(cacheDirOption) ? &resultCache : nullptr;
+
+    // В резидентном режиме деревья загружаются по запросам клиентов
+    if (parser.isSet(daemonOption)) {
+        CoverageDaemon daemon;
+        daemon.resultCache = sharedCache;
+        daemon.limits = limits;
+        if (!daemon.listen(parser.value(daemonOption))) {
+            qCritical() << "Ошибка: не удалось открыть сокет" << parser.value(daemonOption) << daemon.server.errorString();
+            return 1;
+        }
+        qDebug() << "Ожидание запросов на сокете:" << daemon.server.fullServerName();
+        return app.exec();
+    }
+
+    const QStringList positionalArguments = parser.positionalArguments();
+    if (positionalArguments.size() != 2) {
         qCritical() << "Ошибка: Неверное количество аргументов";
-        qCritical() << "Использование:" << argv[0] << "<input.dot> <output.txt>";
-        qWarning() << "Примечание: второй аргумент игнорируется, результат записывается в coverage_result.txt";
+        qCritical() << "Использование:" << argv[0] << "--daemon socket [--cache n] [--cache-dir directory] [--max-nodes n] [--max-edges n] [--max-depth n] [--max-input-bytes n] [--max-time-ms ms] [--max-memory-mb mb]";
+        qCritical() << "Использование:" << argv[0] << "[--profile | --forest | --diff previous.state [--diff-output diff.txt] [--save-state current.state] | --batch [--threads n] [--pipeline] | --watch [--debounce ms]] [--cache n] [--cache-dir directory] [--suggest k] [--export-csv nodes.csv] [--export-columns directory] [--format text|json] [--stats] [--stats-file stats.jsonl] [--visit-warning-factor k] [--trace trace.json [--trace-zones]] [--max-nodes n] [--max-edges n] [--max-depth n] [--max-input-bytes n] [--max-time-ms ms] [--max-memory-mb mb] <input.dot> <output.txt>";
         return 1;
     }
 
-    const QString inputFile = argv[1];
+    const QString inputFile = positionalArguments.at(0);
+    const QString outputFile = positionalArguments.at(1);
 
-    // 2. Чтение входного DOT-файла
-    qDebug() << "Чтение файла:" << inputFile;
-    QFile dotFile(inputFile);
-    if (!dotFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qCritical() << "Ошибка при открытии файла для чтения:" << inputFile;
+    int suggestionCount = 0;
+    if (parser.isSet(suggestOption)) {
+        bool isNumber = false;
+        suggestionCount = parser.value(suggestOption).toInt(&isNumber);
+        if (!isNumber || suggestionCount <= 0) {
+            qCritical() << "Ошибка: параметр --suggest должен быть положительным числом";
+            return 1;
+        }
+    }
+
+    const QString format = parser.value(formatOption);
+    if (format != "text" && format != "json") {
+        qCritical() << "Ошибка: неизвестный формат вывода" << format;
         return 1;
     }
+    const TreeCoverageAnalyzer::ResultFormat resultFormat = format == "json" ? TreeCoverageAnalyzer::JsonFormat : TreeCoverageAnalyzer::TextFormat;
 
-    QString dotContent = QString::fromUtf8(dotFile.readAll());
-    dotFile.close();
+    // Лес анализируется по компонентам, для которых результаты предыдущей ревизии не сопоставляются
+    if ((parser.isSet(diffOption) || parser.isSet(saveStateOption)) && parser.isSet(forestOption)) {
+        qCritical() << "Ошибка: параметры --diff и --save-state нельзя использовать вместе с --forest";
+        return 1;
+    }
+
+    // В пакетном режиме каждый файл анализируется отдельным анализатором на пуле потоков
+    if (parser.isSet(batchOption)) {
+        BatchAnalyzer batch;
+        if (parser.isSet(threadsOption)) {
+            bool isNumber = false;
+            batch.threadCount = parser.value(threadsOption).toInt(&isNumber);
+            if (!isNumber || batch.threadCount <= 0) {
+                qCritical() << "Ошибка: параметр --threads должен быть положительным числом";
+                return 1;
+            }
+        }
+        batch.isPipelined = parser.isSet(pipelineOption);
+        batch.resultCache = sharedCache;
+        batch.trace = trace;
+        batch.limits = limits;
+        batch.suggestionCount = suggestionCount;
+        batch.resultFormat = resultFormat;
+        batch.outputDirectory = outputFile;
+        if (!batch.collectInputs(inputFile)) {
+            qCritical() << "Ошибка при открытии файла-списка для чтения:" << inputFile;
+            return 1;
+        }
+        qDebug() << "Пакетный анализ файлов:" << batch.inputFiles.size();
+        statistics.startPhase("batch");
+        TraceRecorder::Span batchSpan(trace, "batch", "main", inputFile);
+        const bool isWritten = batch.run();
+        batchSpan.finish();
+        if (!writeReports()) {
+            return 1;
+        }
+        if (!isWritten) {
+            qCritical() << "Ошибка при записи итоговой таблицы в каталог:" << outputFile;
+            return 1;
+        }
+        qDebug() << "Итоговая таблица сохранена в:" << QDir(outputFile).filePath("summary.csv");
+        if (batch.failedCount > 0) {
+            qCritical() << "Не удалось прочитать или записать файлов:" << batch.failedCount;
+            return 1;
+        }
+        return 0;
+    }
+
+    // В режиме наблюдения анализатор остается в памяти и повторяет анализ после изменений файла
+    if (parser.isSet(watchOption)) {
+        bool isNumber = false;
+        const int debounceMs = parser.value(debounceOption).toInt(&isNumber);
+        if (!isNumber || debounceMs < 0) {
+            qCritical() << "Ошибка: параметр --debounce должен быть неотрицательным числом";
+            return 1;
+        }
+        CoverageWatcher watcher;
+        watcher.analyzer.suggestionCount = suggestionCount;
+        watcher.analyzer.resultFileName = outputFile;
+        watcher.analyzer.resultFormat = resultFormat;
+        watcher.analyzer.limits = limits;
+        if (!watcher.start(inputFile, debounceMs)) {
+            qCritical() << "Ошибка: не удалось наблюдать за файлом" << inputFile;
+            return 1;
+        }
+        qDebug() << "Наблюдение за файлом:" << inputFile;
+        return app.exec();
+    }
+
+    // Найденные ошибки завершают программу (статистика записывается заранее). В формате JSON ошибки записываются
+    // в выходной файл тем же объектом, что и результат, иначе - текстовым отчетом parse_errors.txt или graph_errors.txt
+    auto exitOnErrors = [&](TreeCoverageAnalyzer& checked, bool isParseStage) {
+        if (checked.errors.isEmpty()) {
+            return;
+        }
+        writeReports();
+        if (resultFormat == TreeCoverageAnalyzer::JsonFormat) {
+            checked.resultFileName = outputFile;
+            checked.resultFormat = resultFormat;
+            checked.getResult();
+            exit(1);
+        }
+        if (isParseStage) {
+            checked.checkErrorsAfterParseDOT();
+        }
+        else {
+            checked.checkErrorsAfterTreeGraphTakeErrors();
+        }
+    };
+
+    // 2. Чтение входного DOT-файла (файл больше ограничения не читается)
+    if (limits && limits->maxInputBytes > 0 && QFileInfo(inputFile).size() > limits->maxInputBytes) {
+        TreeCoverageAnalyzer rejected;
+        rejected.errors.append(Error(Error::LimitExceeded, QString("размер входного файла %1 больше %2 байт").arg(QFileInfo(inputFile).size()).arg(limits->maxInputBytes)));
+        exitOnErrors(rejected, true);
+    }
+    statistics.startPhase("read");
+    TraceRecorder::Span readSpan(trace, "read", "main", inputFile);
+    QString dotContent;
+    if (!readDotFile(inputFile, dotContent)) {
+        return 1;
+    }
+    readSpan.finish();
+    statistics.inputBytes = QFileInfo(inputFile).size();
+
+    // Выгрузка покрытия каждого узла, если она запрошена
+    auto exportNodeCoverage = [&](const TreeCoverageAnalyzer& analyzer) {
+        if (!parser.isSet(exportCsvOption) && !parser.isSet(exportColumnsOption)) {
+            return true;
+        }
+        CoverageExporter exporter(analyzer);
+        if (parser.isSet(exportCsvOption) && !exporter.writeCsv(parser.value(exportCsvOption))) {
+            qCritical() << "Ошибка при записи файла:" << parser.value(exportCsvOption);
+            return false;
+        }
+        if (parser.isSet(exportColumnsOption) && !exporter.writeColumns(parser.value(exportColumnsOption))) {
+            qCritical() << "Ошибка при записи столбцов в каталог:" << parser.value(exportColumnsOption);
+            return false;
+        }
+        return true;
+    };
 
     // 3. Создание анализатора покрытия дерева
     TreeCoverageAnalyzer analyzer;
+    analyzer.suggestionCount = suggestionCount;
+    analyzer.resultFileName = outputFile;
+    analyzer.resultFormat = resultFormat;
+    analyzer.statistics = isStatisticsEnabled ? &statistics : nullptr;
+    analyzer.trace = trace;
+    analyzer.limits = limits;
 
     // 4. Парсинг DOT-контента
     qDebug() << "Парсинг DOT-файла...";
+    statistics.startPhase("parseDOT");
+    TraceRecorder::Span parseSpan(trace, "parseDOT", "parse");
     analyzer.parseDOT(dotContent);
+    parseSpan.finish();
+    statistics.countTree(analyzer);
+
+    // 5. Проверка ошибок парсинга (в том числе до профиля, чтобы пустой или неразобранный файл не давал пустой профиль)
+    exitOnErrors(analyzer, true);
 
-    // 5. Проверка ошибок парсинга
-    analyzer.checkErrorsAfterParseDOT();
+    // В режиме профиля граф описывается сразу после разбора, проверка и анализ покрытия не выполняются
+    if (parser.isSet(profileOption)) {
+        statistics.startPhase("profile");
+        TraceRecorder::Span profileSpan(trace, "profile", "main");
+        const GraphProfile profile(analyzer.treeMap);
+        profileSpan.finish();
+        if (!profile.write(outputFile, resultFormat)) {
+            qCritical() << "Ошибка при записи профиля в файл:" << outputFile;
+            return 1;
+        }
+        qDebug() << "Профиль графа сохранен в:" << outputFile;
+        return writeReports() ? 0 : 1;
+    }
 
-    // 6. Заполнение хэш-таблицы и проверка графа
+    // 6. В режиме леса каждая компонента проверяется и анализируется отдельно
+    if (parser.isSet(forestOption)) {
+        qDebug() << "Анализ покрытия леса...";
+        statistics.startPhase("analyzeForest");
+        analyzer.analyzeForest();
+        statistics.countVisits(analyzer);
+        statistics.startPhase("getResult");
+        analyzer.getForestResult();
+        qDebug() << "Результат сохранен в:" << outputFile;
+        if (!exportNodeCoverage(analyzer) || !writeReports()) {
+            return 1;
+        }
+        for (const TreeCoverageAnalyzer* componentAnalyzer : analyzer.forest) {
+            if (componentAnalyzer->isLimitExceeded) {
+                qCritical() << "Анализ компоненты остановлен:" << componentAnalyzer->errors.last().errMessage();
+                return 1;
+            }
+        }
+        qDebug() << "Программа завершена успешно.";
+        return 0;
+    }
+
+    // 7. Заполнение хэш-таблицы и проверка графа
     analyzer.fillHash(analyzer.treeMap, analyzer.amountOfParents);
-    analyzer.checkErrorsAfterTreeGraphTakeErrors();
+    exitOnErrors(analyzer, false);
 
-    // 7. Анализ покрытия дерева
+    // 8. В режиме сравнения загружаем снимок предыдущей ревизии, чтобы переиспользовать ее результаты.
+    //    Если вместо снимка указан DOT-файл, предыдущая ревизия разбирается и анализируется заново
+    RevisionState previousState;
+    if (parser.isSet(diffOption)) {
+        statistics.startPhase("loadState");
+        if (!previousState.read(parser.value(diffOption))) {
+            QString previousContent;
+            if (!readDotFile(parser.value(diffOption), previousContent)) {
+                return 1;
+            }
+            TreeCoverageAnalyzer previous;
+            previous.parseDOT(previousContent);
+            exitOnErrors(previous, true);
+            previous.fillHash(previous.treeMap, previous.amountOfParents);
+            exitOnErrors(previous, false);
+            previous.computeSubtreeHashes();
+            previous.analyzeZoneWithExtraNodes(*previous.rootNodes.begin());
+            previousState = RevisionState::fromAnalyzer(previous);
+        }
+
+        qDebug() << "Сравнение ревизий дерева...";
+        statistics.startPhase("diff");
+        analyzer.computeSubtreeHashes();
+        analyzer.diffWith(previousState);
+    }
+    else if (parser.isSet(saveStateOption)) {
+        analyzer.computeSubtreeHashes();
+    }
+
+    // 9. Анализ покрытия дерева
     qDebug() << "Анализ покрытия дерева...";
+    TraceRecorder::Span coverageSpan(trace, "analyzeTreeCoverage", "coverage");
     analyzer.analyzeTreeCoverage();
+    coverageSpan.finish();
+    if (analyzer.isLimitExceeded) {
+        // Отчет с ошибкой LimitExceeded уже записан в выходной файл методом getResult
+        qCritical() << "Анализ остановлен:" << analyzer.errors.last().errMessage();
+        writeReports();
+        return 1;
+    }
 
-    // 8. Результат уже записан в coverage_result.txt методом getResult
-    qDebug() << "Результат сохранен в: coverage_result.txt";
+    // 10. Результат уже записан в выходной файл методом getResult
+    qDebug() << "Результат сохранен в:" << outputFile;
+    if (parser.isSet(diffOption)) {
+        const QString diffFile = parser.isSet(diffOutputOption) ? parser.value(diffOutputOption)
+                                                                : QFileInfo(outputFile).dir().filePath("diff_result.txt");
+        analyzer.getDiffResult(diffFile);
+        qDebug() << "Отчет о различиях сохранен в:" << diffFile;
+    }
+    if (parser.isSet(exportCsvOption) || parser.isSet(exportColumnsOption) || parser.isSet(saveStateOption)) {
+        analyzer.resolveReusedStatuses();
+    }
+    if (parser.isSet(saveStateOption)) {
+        if (!RevisionState::fromAnalyzer(analyzer).write(parser.value(saveStateOption))) {
+            qCritical() << "Ошибка при записи снимка ревизии в файл:" << parser.value(saveStateOption);
+            return 1;
+        }
+        qDebug() << "Снимок ревизии сохранен в:" << parser.value(saveStateOption);
+    }
+    if (!exportNodeCoverage(analyzer) || !writeReports()) {
+        return 1;
+    }
 
-    // 9. Программа завершена успешно
+    // 11. Программа завершена успешно
     qDebug() << "Программа завершена успешно.";
     return 0;
 }
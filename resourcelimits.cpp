@@ -0,0 +1,36 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса ResourceLimits.
+*/
+
+#include "resourcelimits.h"
+
+ResourceLimits::ResourceLimits()
+    : maxNodes(0), maxEdges(0), maxDepth(0), maxInputBytes(0), maxTimeMs(0), maxMemoryBytes(0) {}
+
+bool ResourceLimits::isEnabled() const {
+    return maxNodes > 0 || maxEdges > 0 || maxDepth > 0 || maxInputBytes > 0 || maxTimeMs > 0 || maxMemoryBytes > 0;
+}
+
+qint64 ResourceLimits::estimateMemoryBytes(qint64 inputBytes, qint64 nodeCount, qint64 edgeCount) {
+    return inputBytes + nodeCount * EstimatedBytesPerNode + edgeCount * EstimatedBytesPerEdge;
+}
+
+bool ResourceLimits::checkTime(qint64 elapsedMs, QString& details) const {
+    if (maxTimeMs > 0 && elapsedMs > maxTimeMs) {
+        details = QString("время анализа %1 мс больше %2 мс").arg(elapsedMs).arg(maxTimeMs);
+        return false;
+    }
+    return true;
+}
+
+bool ResourceLimits::checkMemory(qint64 inputBytes, qint64 nodeCount, qint64 edgeCount, QString& details) const {
+    if (maxMemoryBytes > 0) {
+        const qint64 memoryBytes = estimateMemoryBytes(inputBytes, nodeCount, edgeCount);
+        if (memoryBytes > maxMemoryBytes) {
+            details = QString("оценка памяти анализатора %1 байт больше %2 байт").arg(memoryBytes).arg(maxMemoryBytes);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,73 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса ResourceLimits с ограничениями ресурсов на анализ одного входного файла.
+*/
+
+#ifndef RESOURCELIMITS_H
+#define RESOURCELIMITS_H
+
+#include <QString>
+
+/*!
+* \brief Класс ограничений на размер графа, глубину, размер входа, время и память.
+*
+* Нулевое значение означает отсутствие ограничения. Объект только читается анализаторами, поэтому одни ограничения
+* можно передать анализаторам на разных потоках. При превышении анализатор добавляет ошибку Error::LimitExceeded
+* и прекращает работу так же, как при отмене, вместо переполнения стека или памяти.
+* Время отсчитывается от начала работы анализатора, а память оценивается по данным самого анализатора (текст входа,
+* узлы и ребра), поэтому ни предыдущие файлы пакета, ни анализаторы на соседних потоках и в очереди конвейера
+* не засчитываются проверяемому файлу.
+*/
+class ResourceLimits
+{
+public:
+    /*!
+    * \brief Конструктор по умолчанию: все ограничения сняты
+    */
+    ResourceLimits();
+
+    qint64 maxNodes; //!< наибольшее количество узлов
+    qint64 maxEdges; //!< наибольшее количество ребер
+    qint64 maxDepth; //!< наибольшая глубина узла от корня
+    qint64 maxInputBytes; //!< наибольший размер входных данных в байтах
+    qint64 maxTimeMs; //!< наибольшее время разбора, проверки и анализа одного входа в миллисекундах
+    qint64 maxMemoryBytes; //!< наибольшая оценка памяти данных одного анализатора в байтах (estimateMemoryBytes)
+
+    static constexpr qint64 EstimatedBytesPerNode = 256; //!< оценка памяти узла: Node, имя, записи таблиц разбора, проверки и анализа
+    static constexpr qint64 EstimatedBytesPerEdge = 32; //!< оценка памяти ребра: указатель в списке детей с запасом емкости и счетчик родителей
+
+    /*!
+    * \brief Проверяет, задано ли хотя бы одно ограничение
+    * \return true - если хотя бы одно ограничение не равно нулю
+    */
+    bool isEnabled() const;
+
+    /*!
+    * \brief Оценивает память данных анализатора
+    * \param [in] inputBytes - память текста входа в байтах
+    * \param [in] nodeCount - количество узлов
+    * \param [in] edgeCount - количество ребер
+    * \return оценка в байтах
+    */
+    static qint64 estimateMemoryBytes(qint64 inputBytes, qint64 nodeCount, qint64 edgeCount);
+
+    /*!
+    * \brief Проверяет ограничение по времени
+    * \param [in] elapsedMs - время работы анализатора в миллисекундах
+    * \param [out] details - описание превышенного ограничения
+    * \return true - если ограничение соблюдено
+    */
+    bool checkTime(qint64 elapsedMs, QString& details) const;
+
+    /*!
+    * \brief Проверяет ограничение по памяти
+    * \param [in] inputBytes - память текста входа в байтах
+    * \param [in] nodeCount - количество узлов
+    * \param [in] edgeCount - количество ребер
+    * \param [out] details - описание превышенного ограничения
+    * \return true - если ограничение соблюдено
+    */
+    bool checkMemory(qint64 inputBytes, qint64 nodeCount, qint64 edgeCount, QString& details) const;
+};
+
+#endif // RESOURCELIMITS_H
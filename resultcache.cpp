@@ -0,0 +1,101 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса ResultCache.
+*/
+
+#include "resultcache.h"
+#include "treecoverageanalyzer.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+/*!
+* \brief Признак файла записи кэша и версия его формата
+*/
+static const quint32 CacheFileMagic = 0x54434331;
+
+ResultCache::ResultCache(int capacity, const QString& directory)
+    : directory(directory), hitCount(0), missCount(0), entries(capacity > 0 ? capacity : 1) {
+    if (!directory.isEmpty()) {
+        QDir().mkpath(directory);
+    }
+}
+
+QByteArray ResultCache::key(const QByteArray& structure, const TreeCoverageAnalyzer& analyzer) {
+    // При одинаковой структуре порядок treeMap совпадает, поэтому отметки задаются номерами узлов, а не именами
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(structure);
+    for (int i = 0; i < analyzer.treeMap.size(); ++i) {
+        const Node::Shape shape = analyzer.treeMap[i]->shape;
+        if (shape != Node::Base) {
+            hash.addData(QByteArray::number(i) + ':' + QByteArray::number(static_cast<int>(shape)) + ';');
+        }
+    }
+    hash.addData("suggest:" + QByteArray::number(analyzer.suggestionCount));
+    return hash.result();
+}
+
+bool ResultCache::find(const QByteArray& key, CoverageResult& result) {
+    QMutexLocker locker(&mutex);
+
+    // 1. Запись в памяти
+    if (CoverageResult* entry = entries.object(key)) {
+        result = *entry;
+        hitCount++;
+        return true;
+    }
+
+    // 2. Запись в каталоге, найденная запись возвращается в память
+    if (!directory.isEmpty()) {
+        QFile file(fileName(key));
+        if (file.open(QIODevice::ReadOnly)) {
+            QDataStream in(&file);
+            in.setVersion(QDataStream::Qt_6_0);
+            quint32 magic = 0;
+            CoverageResult stored;
+            in >> magic >> stored;
+            file.close();
+            if (magic == CacheFileMagic && in.status() == QDataStream::Ok) {
+                entries.insert(key, new CoverageResult(stored));
+                result = stored;
+                hitCount++;
+                return true;
+            }
+        }
+    }
+
+    missCount++;
+    return false;
+}
+
+void ResultCache::insert(const QByteArray& key, const CoverageResult& result) {
+    // Прерванный анализ неполон, а превышение ограничений зависит от настроек запуска, а не от дерева
+    if (result.status == CoverageResult::Canceled || result.status == CoverageResult::LimitExceeded) {
+        return;
+    }
+    QMutexLocker locker(&mutex);
+    entries.insert(key, new CoverageResult(result));
+
+    // Запись через временный файл, чтобы прерванная запись не оставила поврежденный файл
+    if (!directory.isEmpty()) {
+        QSaveFile file(fileName(key));
+        if (file.open(QIODevice::WriteOnly)) {
+            QDataStream out(&file);
+            out.setVersion(QDataStream::Qt_6_0);
+            out << CacheFileMagic << result;
+            file.commit();
+        }
+    }
+}
+
+int ResultCache::size() const {
+    QMutexLocker locker(&mutex);
+    return entries.size();
+}
+
+QString ResultCache::fileName(const QByteArray& key) const {
+    return QDir(directory).filePath(QString::fromLatin1(key.toHex()) + ".result");
+}
@@ -0,0 +1,80 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса ResultCache, запоминающего результаты анализа для повторяющихся запросов.
+*/
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QString>
+#include "coverageresult.h"
+
+class TreeCoverageAnalyzer;
+
+/*!
+* \brief Класс кэша результатов анализа с вытеснением давно не использованных записей.
+*
+* Ключ записи - хэш структуры дерева (имена узлов и ребра), хэш отмеченных и целевых узлов и количество предлагаемых отметок,
+* поэтому одинаковые пары (дерево, отметки) из разных файлов и запросов получают один результат.
+* Если задан каталог, записи дополнительно сохраняются в файлы и переживают перезапуск программы.
+* Обращения к кэшу защищены мьютексом, кэш можно разделять между потоками.
+*/
+class ResultCache
+{
+public:
+    /*!
+    * \brief Конструктор кэша
+    * \param [in] capacity - максимальное количество записей в памяти
+    * \param [in] directory - каталог для сохранения записей (пустая строка - только память)
+    */
+    explicit ResultCache(int capacity = 1024, const QString& directory = QString());
+
+    QString directory; //!< каталог для сохранения записей
+    int hitCount; //!< количество найденных результатов
+    int missCount; //!< количество отсутствовавших результатов
+
+    /*!
+    * \brief Вычисляет ключ записи для разобранного дерева анализатора с его текущими отметками
+    * \param [in] structure - хэш структуры дерева (TreeCoverageAnalyzer::structureHash)
+    * \param [in] analyzer - анализатор с разобранным деревом
+    * \return ключ записи
+    */
+    static QByteArray key(const QByteArray& structure, const TreeCoverageAnalyzer& analyzer);
+
+    /*!
+    * \brief Ищет результат в памяти, затем в каталоге
+    * \param [in] key - ключ записи
+    * \param [out] result - найденный результат
+    * \return true - если результат найден, false - в противном случае
+    */
+    bool find(const QByteArray& key, CoverageResult& result);
+
+    /*!
+    * \brief Запоминает результат в памяти и, если задан каталог, в файле
+    * \param [in] key - ключ записи
+    * \param [in] result - результат анализа (отмененный анализ не запоминается)
+    */
+    void insert(const QByteArray& key, const CoverageResult& result);
+
+    /*!
+    * \brief Возвращает количество записей в памяти
+    * \return количество записей
+    */
+    int size() const;
+
+private:
+    QCache<QByteArray, CoverageResult> entries; //!< записи в памяти
+    mutable QMutex mutex; //!< защищает записи и счетчики
+
+    /*!
+    * \brief Возвращает имя файла записи в каталоге
+    * \param [in] key - ключ записи
+    * \return путь к файлу
+    */
+    QString fileName(const QByteArray& key) const;
+};
+
+#endif // RESULTCACHE_H
@@ -0,0 +1,92 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса RevisionState.
+*/
+
+#include "revisionstate.h"
+#include "treecoverageanalyzer.h"
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <algorithm>
+
+/*!
+* \brief Признак файла снимка ревизии и версия его формата
+*/
+static const quint32 RevisionFileMagic = 0x54435331;
+
+RevisionState RevisionState::fromAnalyzer(const TreeCoverageAnalyzer& analyzer) {
+    RevisionState state;
+    const int count = analyzer.subtreeIntervals.size();
+    QVector<Node*> nodes(count, nullptr);
+    for (auto it = analyzer.subtreeIntervals.constBegin(); it != analyzer.subtreeIntervals.constEnd(); ++it) {
+        nodes[it.value().first] = it.key();
+    }
+
+    // 1. Узлы, дети и поддеревья в порядке обхода
+    state.shapes.reserve(count);
+    state.childOffsets.reserve(count + 1);
+    state.subtreeEnds.reserve(count);
+    state.subtreeHashes.reserve(count);
+    state.statuses.reserve(count);
+    for (Node* node : nodes) {
+        state.names.append(node->name);
+        state.shapes.append(static_cast<qint8>(node->shape));
+        state.childOffsets.append(state.childIndices.size());
+        for (Node* child : node->children) {
+            state.childIndices.append(analyzer.subtreeIntervals.value(child).first);
+        }
+        state.subtreeEnds.append(analyzer.subtreeIntervals.value(node).second);
+        state.subtreeHashes.append(analyzer.subtreeHashes.value(node));
+        state.statuses.append(analyzer.nodeStatuses.contains(node) ? static_cast<qint8>(analyzer.nodeStatuses.value(node)) : qint8(-1));
+    }
+    state.childOffsets.append(state.childIndices.size());
+
+    // 2. Результат анализа номерами узлов, упорядоченный для выборки по отрезку поддерева
+    for (Node* node : analyzer.missingNodes) {
+        state.missingNodes.append(analyzer.subtreeIntervals.value(node).first);
+    }
+    std::sort(state.missingNodes.begin(), state.missingNodes.end());
+    for (const QPair<Node*, Node*>& pair : analyzer.redundantNodes) {
+        const int ancestor = pair.first ? analyzer.subtreeIntervals.value(pair.first).first : -1;
+        state.redundantNodes.append(qMakePair(ancestor, analyzer.subtreeIntervals.value(pair.second).first));
+    }
+    std::sort(state.redundantNodes.begin(), state.redundantNodes.end(), [](const QPair<int, int>& left, const QPair<int, int>& right) {
+        return left.second < right.second;
+    });
+    return state;
+}
+
+bool RevisionState::write(const QString& fileName) const {
+    // Запись через временный файл, чтобы прерванная запись не оставила поврежденный снимок
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << RevisionFileMagic << names << shapes << childOffsets << childIndices << subtreeEnds << subtreeHashes
+        << statuses << missingNodes << redundantNodes;
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+bool RevisionState::read(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    in >> magic;
+    if (magic != RevisionFileMagic) {
+        return false;
+    }
+    in >> names >> shapes >> childOffsets >> childIndices >> subtreeEnds >> subtreeHashes >> statuses >> missingNodes >> redundantNodes;
+    file.close();
+
+    // Размеры массивов должны совпадать с количеством узлов
+    const int count = names.size();
+    return in.status() == QDataStream::Ok && shapes.size() == count && childOffsets.size() == count + 1
+           && subtreeEnds.size() == count && subtreeHashes.size() == count && statuses.size() == count;
+}
@@ -0,0 +1,64 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса RevisionState – сохраненных результатов анализа ревизии дерева для режима сравнения.
+*/
+
+#ifndef REVISIONSTATE_H
+#define REVISIONSTATE_H
+
+#include <QByteArray>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class TreeCoverageAnalyzer;
+
+/*!
+* \brief Класс снимка проанализированной ревизии дерева: хэши поддеревьев, статусы покрытия и найденные узлы.
+*
+* Узлы пронумерованы в порядке обхода в глубину (TreeCoverageAnalyzer::subtreeIntervals), поэтому поддерево узла
+* занимает отрезок номеров от самого узла до subtreeEnds. Снимок записывается в файл после анализа и читается
+* при следующем запуске с --diff, так что предыдущая ревизия не разбирается и не анализируется повторно.
+*/
+class RevisionState
+{
+public:
+    QStringList names; //!< имена узлов по номеру обхода
+    QVector<qint8> shapes; //!< формы узлов
+    QVector<int> childOffsets; //!< смещение списка детей узла, последний элемент равен количеству ребер
+    QVector<int> childIndices; //!< номера детей всех узлов подряд
+    QVector<int> subtreeEnds; //!< номер последнего узла поддерева
+    QVector<QByteArray> subtreeHashes; //!< хэши поддеревьев (TreeCoverageAnalyzer::hashSubtree)
+    QVector<qint8> statuses; //!< статусы покрытия из зоны недостающих узлов (-1 - статус не вычислялся)
+    QVector<int> missingNodes; //!< номера недостающих узлов по возрастанию
+    QVector<QPair<int, int>> redundantNodes; //!< пары номеров (отмеченный предок, избыточный узел) по возрастанию номера избыточного узла
+
+    /*!
+    * \brief Создает снимок анализатора с вычисленными хэшами поддеревьев и завершенным анализом покрытия
+    * \param [in] analyzer - анализатор ревизии (статусы переиспользованных поддеревьев должны быть восстановлены)
+    * \return снимок ревизии
+    */
+    static RevisionState fromAnalyzer(const TreeCoverageAnalyzer& analyzer);
+
+    /*!
+    * \brief Записывает снимок в двоичный файл
+    * \param [in] fileName - имя файла
+    * \return true - если файл записан
+    */
+    bool write(const QString& fileName) const;
+
+    /*!
+    * \brief Читает снимок из двоичного файла
+    * \param [in] fileName - имя файла
+    * \return true - если файл прочитан и является снимком ревизии
+    */
+    bool read(const QString& fileName);
+
+    /*!
+    * \brief Возвращает количество узлов ревизии
+    */
+    int size() const { return names.size(); }
+};
+
+#endif // REVISIONSTATE_H
@@ -0,0 +1,192 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса RunStatistics.
+*/
+
+#include "runstatistics.h"
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+#include "treecoverageanalyzer.h"
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+RunStatistics::RunStatistics()
+    : isPhaseRunning(false), inputBytes(0), nodeCount(0), edgeCount(0), visitWarningFactor(4.0) {
+    timer.start();
+}
+
+void RunStatistics::startPhase(const QString& name) {
+    stopPhase();
+    Phase phase;
+    phase.name = name;
+    phase.startNs = timer.nsecsElapsed();
+    phases.append(phase);
+    phases.last().startAllocations = AllocationProfiler::snapshot();
+    isPhaseRunning = true;
+}
+
+void RunStatistics::stopPhase() {
+    if (isPhaseRunning) {
+        phases.last().durationNs = timer.nsecsElapsed() - phases.last().startNs;
+        const AllocationProfiler::Counters counters = AllocationProfiler::snapshot();
+        phases.last().allocations.allocations = counters.allocations - phases.last().startAllocations.allocations;
+        phases.last().allocations.frees = counters.frees - phases.last().startAllocations.frees;
+        phases.last().allocations.bytes = counters.bytes - phases.last().startAllocations.bytes;
+        isPhaseRunning = false;
+    }
+}
+
+void RunStatistics::countTree(const TreeCoverageAnalyzer& analyzer) {
+    nodeCount = analyzer.treeMap.size();
+    edgeCount = 0;
+    for (Node* node : analyzer.treeMap) {
+        edgeCount += node->children.size();
+    }
+}
+
+void RunStatistics::countVisits(const TreeCoverageAnalyzer& analyzer) {
+    visitCounts = analyzer.totalVisitCounts();
+}
+
+QStringList RunStatistics::visitWarnings() const {
+    QStringList warnings;
+    for (int function = 0; function < visitCounts.size(); ++function) {
+        if (nodeCount > 0 && visitCounts[function] > visitWarningFactor * nodeCount) {
+            warnings.append(QString("%1 посетила узлы %2 раз при %3 узлах (больше %4 на узел)")
+                            .arg(TreeCoverageAnalyzer::traversalFunctionName(static_cast<TreeCoverageAnalyzer::TraversalFunction>(function)))
+                            .arg(visitCounts[function]).arg(nodeCount).arg(visitWarningFactor));
+        }
+    }
+    return warnings;
+}
+
+qint64 RunStatistics::peakResidentBytes() {
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return static_cast<qint64>(usage.ru_maxrss); // macOS сообщает байты
+#else
+    return static_cast<qint64>(usage.ru_maxrss) * 1024; // Linux сообщает килобайты
+#endif
+#else
+    return 0;
+#endif
+}
+
+void RunStatistics::writeJson(JsonStreamWriter& json) const {
+    const qint64 peakBytes = peakResidentBytes();
+
+    // 1. Стадии в порядке выполнения
+    json.key("phases");
+    json.beginArray();
+    for (const Phase& phase : phases) {
+        json.beginObject();
+        json.key("name");
+        json.value(phase.name);
+        json.key("start_ns");
+        json.value(phase.startNs);
+        json.key("duration_ns");
+        json.value(phase.durationNs);
+        if (AllocationProfiler::isEnabled()) {
+            json.key("allocations");
+            json.value(phase.allocations.allocations);
+            json.key("frees");
+            json.value(phase.allocations.frees);
+            json.key("allocated_bytes");
+            json.value(phase.allocations.bytes);
+        }
+        json.endObject();
+    }
+    json.endArray();
+    json.key("total_ns");
+    json.value(timer.nsecsElapsed());
+
+    // 2. Размер дерева и память
+    json.key("input_bytes");
+    json.value(inputBytes);
+    json.key("nodes");
+    json.value(nodeCount);
+    json.key("edges");
+    json.value(edgeCount);
+    json.key("peak_rss_bytes");
+    json.value(peakBytes);
+    json.key("bytes_per_node");
+    json.value(nodeCount > 0 ? static_cast<double>(peakBytes) / nodeCount : 0.0);
+
+    // 3. Посещения узлов функциями обхода
+    json.key("visits");
+    json.beginObject();
+    qint64 totalVisits = 0;
+    for (int function = 0; function < visitCounts.size(); ++function) {
+        json.key(TreeCoverageAnalyzer::traversalFunctionName(static_cast<TreeCoverageAnalyzer::TraversalFunction>(function)));
+        json.value(visitCounts[function]);
+        totalVisits += visitCounts[function];
+    }
+    json.endObject();
+    json.key("visits_total");
+    json.value(totalVisits);
+    json.key("visit_warnings");
+    json.beginArray();
+    for (const QString& warning : visitWarnings()) {
+        json.value(warning);
+    }
+    json.endArray();
+
+    // 4. Выделения памяти с начала работы программы
+    if (AllocationProfiler::isEnabled()) {
+        const AllocationProfiler::Counters counters = AllocationProfiler::snapshot();
+        json.key("allocation_source");
+        json.value(AllocationProfiler::source());
+        json.key("allocations");
+        json.value(counters.allocations);
+        json.key("frees");
+        json.value(counters.frees);
+        json.key("allocated_bytes");
+        json.value(counters.bytes);
+    }
+}
+
+bool RunStatistics::write(const QString& fileName) {
+    stopPhase();
+    for (const QString& warning : visitWarnings()) {
+        qWarning().noquote() << "Предупреждение:" << warning;
+    }
+    QFile file;
+    bool isOpened = false;
+    if (fileName.isEmpty()) {
+        isOpened = file.open(stderr, QIODevice::WriteOnly | QIODevice::Text);
+    }
+    else {
+        file.setFileName(fileName);
+        isOpened = file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+    }
+    if (!isOpened) {
+        return false;
+    }
+    QTextStream out(&file);
+    JsonStreamWriter json(out);
+    json.beginObject();
+    writeJson(json);
+    json.endObject();
+    out << "\n";
+    out.flush();
+    return true;
+}
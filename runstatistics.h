@@ -0,0 +1,107 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса RunStatistics, собирающего время стадий и расход памяти одного запуска.
+*/
+
+#ifndef RUNSTATISTICS_H
+#define RUNSTATISTICS_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "allocationprofiler.h"
+#include "jsonstreamwriter.h"
+
+class TreeCoverageAnalyzer;
+
+/*!
+* \brief Класс статистики запуска: время каждой стадии, пиковый объем резидентной памяти и размер дерева.
+*
+* Статистика записывается одной строкой JSON, чтобы системы мониторинга могли разбирать ее построчно.
+* Стадии идут последовательно: начало новой стадии завершает текущую.
+* Посещения узлов рекурсивными функциями обхода сравниваются с количеством узлов: если функция посетила узлы больше
+* чем visitWarningFactor раз на узел, в статистику и в поток ошибок записывается предупреждение.
+* В сборке с CONFIG+=allocation_profiler для каждой стадии также записываются выделения и освобождения памяти.
+*/
+class RunStatistics
+{
+public:
+    /*!
+    * \brief Стадия запуска
+    */
+    class Phase
+    {
+    public:
+        QString name; //!< имя стадии
+        qint64 startNs = 0; //!< начало стадии от начала запуска в наносекундах
+        qint64 durationNs = 0; //!< продолжительность стадии в наносекундах
+        AllocationProfiler::Counters startAllocations; //!< счетчики выделений памяти в начале стадии
+        AllocationProfiler::Counters allocations; //!< выделения памяти за время стадии
+    };
+
+    /*!
+    * \brief Конструктор, начинающий отсчет времени запуска
+    */
+    RunStatistics();
+
+    QElapsedTimer timer; //!< таймер от начала запуска
+    QList<Phase> phases; //!< завершенные и текущая стадии в порядке начала
+    bool isPhaseRunning; //!< последняя стадия еще не завершена
+    qint64 inputBytes; //!< размер входных данных в байтах
+    int nodeCount; //!< количество узлов графа
+    int edgeCount; //!< количество ребер графа
+    QVector<qint64> visitCounts; //!< количество посещений узлов по функциям обхода (индекс - TreeCoverageAnalyzer::TraversalFunction)
+    double visitWarningFactor; //!< допустимое количество посещений на узел для каждой функции обхода
+
+    /*!
+    * \brief Завершает текущую стадию и начинает новую
+    * \param [in] name - имя новой стадии
+    */
+    void startPhase(const QString& name);
+
+    /*!
+    * \brief Завершает текущую стадию
+    */
+    void stopPhase();
+
+    /*!
+    * \brief Запоминает количество узлов и ребер графа анализатора
+    * \param [in] analyzer - анализатор с разобранным графом
+    */
+    void countTree(const TreeCoverageAnalyzer& analyzer);
+
+    /*!
+    * \brief Запоминает количество посещений узлов функциями обхода анализатора и компонент леса
+    * \param [in] analyzer - анализатор после проверки графа или анализа покрытия
+    */
+    void countVisits(const TreeCoverageAnalyzer& analyzer);
+
+    /*!
+    * \brief Составляет предупреждения о функциях обхода, посетивших узлы больше visitWarningFactor раз на узел
+    * \return тексты предупреждений
+    */
+    QStringList visitWarnings() const;
+
+    /*!
+    * \brief Возвращает пиковый объем резидентной памяти процесса
+    * \return объем в байтах или 0, если платформа его не сообщает
+    */
+    static qint64 peakResidentBytes();
+
+    /*!
+    * \brief Записывает поля статистики в JSON-объект
+    * \param [out] json – писатель JSON, в котором уже открыт объект
+    */
+    void writeJson(JsonStreamWriter& json) const;
+
+    /*!
+    * \brief Завершает текущую стадию и дописывает строку статистики
+    * \param [in] fileName - файл, в конец которого дописывается строка (пустая строка - стандартный поток ошибок)
+    * \return true - если строка записана, false - если файл не удалось открыть
+    */
+    bool write(const QString& fileName);
+};
+
+#endif // RUNSTATISTICS_H
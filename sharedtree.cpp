@@ -0,0 +1,153 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций классов SharedTree и CoverageQuery.
+*/
+
+#include "sharedtree.h"
+#include "topcandidates.h"
+#include <algorithm>
+
+SharedTree::SharedTree(const TreeCoverageAnalyzer& analyzer)
+    : root(-1) {
+    // 1. Номера узлов совпадают с порядком treeMap, поэтому результаты упорядочиваются так же, как у анализатора
+    const QList<Node*>& treeMap = analyzer.treeMap;
+    QHash<Node*, int> nodeIndices;
+    names.reserve(treeMap.size());
+    shapes.reserve(treeMap.size());
+    for (int i = 0; i < treeMap.size(); ++i) {
+        nodeIndices.insert(treeMap[i], i);
+        indices.insert(treeMap[i]->name, i);
+        names.append(treeMap[i]->name);
+        shapes.append(static_cast<qint8>(treeMap[i]->shape));
+    }
+
+    // 2. Списки детей раскладываются подряд
+    childOffsets.resize(treeMap.size() + 1);
+    for (int i = 0; i < treeMap.size(); ++i) {
+        childOffsets[i] = childIndices.size();
+        for (Node* child : treeMap[i]->children) {
+            childIndices.append(nodeIndices.value(child));
+        }
+    }
+    childOffsets[treeMap.size()] = childIndices.size();
+
+    if (!analyzer.rootNodes.isEmpty()) {
+        root = nodeIndices.value(*analyzer.rootNodes.begin(), -1);
+    }
+    structure = analyzer.structureHash();
+}
+
+QSharedPointer<const SharedTree> SharedTree::load(const QString& content, CoverageResult& failure) {
+    // Анализатор нужен только на время разбора и проверки, его узлы удаляются при выходе
+    TreeCoverageAnalyzer analyzer;
+    CoverageResult::Status status;
+    if (!analyzer.validate(content, status)) {
+        failure = analyzer.buildResult(status);
+        return QSharedPointer<const SharedTree>();
+    }
+    return QSharedPointer<const SharedTree>(new SharedTree(analyzer));
+}
+
+CoverageQuery::CoverageQuery(const QSharedPointer<const SharedTree>& tree)
+    : tree(tree), shapes(tree->shapes), suggestionCount(0) {
+}
+
+bool CoverageQuery::selectNodes(const QStringList& names, QStringList& invalidNames) {
+    // 1. Проверяем имена до изменения отметок
+    QVector<bool> selection(tree->size(), false);
+    invalidNames.clear();
+    for (const QString& name : names) {
+        const int node = tree->indices.value(name, -1);
+        if (node < 0 || tree->shapes[node] == Node::Target) {
+            invalidNames.append(name);
+        }
+        else {
+            selection[node] = true;
+        }
+    }
+    if (!invalidNames.isEmpty()) {
+        return false;
+    }
+
+    // 2. Переставляем отметки нецелевых узлов только в копии форм запроса
+    for (int node = 0; node < tree->size(); ++node) {
+        if (tree->shapes[node] != Node::Target) {
+            shapes[node] = static_cast<qint8>(selection[node] ? Node::Selected : Node::Base);
+        }
+    }
+    return true;
+}
+
+CoverageResult CoverageQuery::analyze() const {
+    // 1. Обход по общему дереву, все изменяемые данные принадлежат движку этого вызова
+    SharedTreePolicy policy;
+    policy.shared = tree.data();
+    policy.shapes = shapes;
+    SharedCoverageEngine engine(policy);
+    engine.analyzeTree(tree->root);
+
+    // 2. Номера возрастают в порядке treeMap, поэтому списки уже упорядочены как у анализатора
+    CoverageResult result;
+    for (int node = 0; node < tree->size(); ++node) {
+        if (shapes[node] == Node::Target) {
+            result.targetNodes.append(tree->names[node]);
+        }
+    }
+    const QList<int> extraNodes = engine.extraNodes.values();
+    for (int node : extraNodes) {
+        result.extraNodes.append(tree->names[node]);
+    }
+    const QList<int> missingNodes = engine.missingNodes.values();
+    for (int node : missingNodes) {
+        result.missingNodes.append(tree->names[node]);
+    }
+    QList<QPair<int, int>> redundantNodes = engine.redundantNodes;
+    std::sort(redundantNodes.begin(), redundantNodes.end(), [](const QPair<int, int>& first, const QPair<int, int>& second) {
+        return first.second != second.second ? first.second < second.second : first.first < second.first;
+    });
+    for (const QPair<int, int>& pair : redundantNodes) {
+        result.redundantNodes.append(qMakePair(tree->names[pair.first], tree->names[pair.second]));
+    }
+
+    // 3. Предложения отметок: лучше узел, покрывающий больше листьев, при равенстве – с меньшим именем
+    if (suggestionCount > 0) {
+        auto isBetter = [this](const QPair<int, int>& first, const QPair<int, int>& second) {
+            if (first.second != second.second) {
+                return first.second > second.second;
+            }
+            return tree->names[first.first] < tree->names[second.first];
+        };
+        TopCandidates<QPair<int, int>, decltype(isBetter)> candidates(suggestionCount, isBetter);
+        for (int node : missingNodes) {
+            candidates.offer(qMakePair(node, countUncoveredLeaves(node)));
+        }
+        for (const QPair<int, int>& candidate : candidates.take()) {
+            result.suggestedNodes.append(qMakePair(tree->names[candidate.first], candidate.second));
+        }
+    }
+
+    const bool covered = result.extraNodes.isEmpty() && result.redundantNodes.isEmpty() && result.missingNodes.isEmpty();
+    result.status = covered ? CoverageResult::Covered : CoverageResult::NotCovered;
+    return result;
+}
+
+int CoverageQuery::countUncoveredLeaves(int node) const {
+    int count = 0;
+    QVector<int> stack(1, node);
+    while (!stack.isEmpty()) {
+        const int current = stack.takeLast();
+        // Под отмеченным узлом все листья уже покрыты
+        if (shapes[current] == Node::Selected) {
+            continue;
+        }
+        const int begin = tree->childOffsets[current];
+        const int end = tree->childOffsets[current + 1];
+        if (begin == end) {
+            count += shapes[current] == Node::Base ? 1 : 0;
+        }
+        for (int position = begin; position < end; ++position) {
+            stack.append(tree->childIndices[position]);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,116 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл классов SharedTree и CoverageQuery: неизменяемое дерево, общее для потоков, и контекст одного запроса покрытия.
+*/
+
+#ifndef SHAREDTREE_H
+#define SHAREDTREE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "coverageengine.h"
+#include "coverageresult.h"
+
+/*!
+* \brief Класс разобранного и проверенного дерева, которое после создания не изменяется.
+*
+* Узлы пронумерованы в порядке treeMap анализатора, дети хранятся плоскими массивами.
+* Так как объект только читается, его можно одновременно анализировать из нескольких потоков без блокировок:
+* отметки и результаты каждого запроса хранятся в отдельном CoverageQuery.
+*/
+class SharedTree
+{
+public:
+    /*!
+    * \brief Конструктор, копирующий дерево из анализатора, прошедшего проверку графа
+    * \param [in] analyzer - анализатор с деревом без ошибок
+    */
+    explicit SharedTree(const TreeCoverageAnalyzer& analyzer);
+
+    QStringList names; //!< имена узлов в порядке номеров
+    QVector<qint8> shapes; //!< формы узлов, заданные в файле
+    QVector<int> childOffsets; //!< смещение списка детей узла, последний элемент равен количеству ребер
+    QVector<int> childIndices; //!< номера детей всех узлов подряд
+    QHash<QString, int> indices; //!< таблица имя - номер узла
+    int root; //!< номер корня дерева
+    QByteArray structure; //!< хэш структуры дерева (TreeCoverageAnalyzer::structureHash)
+
+    /*!
+    * \brief Разбирает DOT-контент и проверяет, что граф является деревом
+    * \param [in] content - содержимое DOT-файла
+    * \param [out] failure - результат с ошибками, если дерево не создано
+    * \return общее дерево или пустой указатель при ошибках разбора или проверки
+    */
+    static QSharedPointer<const SharedTree> load(const QString& content, CoverageResult& failure);
+
+    /*!
+    * \brief Возвращает количество узлов дерева
+    */
+    int size() const { return names.size(); }
+};
+
+/*!
+* \brief Стратегия хранения дерева для CoverageEngine: структура берется из общего дерева, формы – из отметок запроса
+*/
+class SharedTreePolicy
+{
+public:
+    const SharedTree* shared = nullptr; //!< общее дерево
+    QVector<qint8> shapes; //!< формы узлов с отметками запроса
+
+    int size() const { return shapes.size(); }
+    Node::Shape shape(int node) const { return static_cast<Node::Shape>(shapes[node]); }
+    int childCount(int node) const { return shared->childOffsets[node + 1] - shared->childOffsets[node]; }
+    int child(int node, int position) const { return shared->childIndices[shared->childOffsets[node] + position]; }
+};
+
+/*!
+* \brief Вариант анализа покрытия по общему дереву
+*/
+typedef CoverageEngine<SharedTreePolicy, BitSetPolicy, IterativeTraversal> SharedCoverageEngine;
+
+/*!
+* \brief Класс одного запроса покрытия к общему дереву: отметки узлов и промежуточные данные анализа.
+*
+* Каждый поток создает свой запрос, дерево при этом не копируется и не изменяется.
+*/
+class CoverageQuery
+{
+public:
+    /*!
+    * \brief Конструктор запроса с отметками из файла
+    * \param [in] tree - общее дерево, запрос продлевает время его жизни
+    */
+    explicit CoverageQuery(const QSharedPointer<const SharedTree>& tree);
+
+    QSharedPointer<const SharedTree> tree; //!< общее дерево
+    QVector<qint8> shapes; //!< формы узлов с отметками запроса
+    int suggestionCount; //!< количество предлагаемых для отметки узлов (0 - предложения не подбираются)
+
+    /*!
+    * \brief Переставляет отметки нецелевых узлов запроса (аналог TreeCoverageAnalyzer::selectNodes)
+    * \param [in] names - имена узлов, которые должны быть отмечены, остальные нецелевые узлы становятся обычными
+    * \param [out] invalidNames - имена, которых нет в дереве или которые принадлежат целевым узлам
+    * \return true - если отметки применены, false - если есть недопустимые имена (отметки не изменяются)
+    */
+    bool selectNodes(const QStringList& names, QStringList& invalidNames);
+
+    /*!
+    * \brief Анализирует покрытие общего дерева с отметками запроса
+    * \return результат анализа, совпадающий с результатом TreeCoverageAnalyzer для тех же отметок
+    */
+    CoverageResult analyze() const;
+
+    /*!
+    * \brief Считает количество непокрытых листьев в поддереве узла (аналог TreeCoverageAnalyzer::countUncoveredLeaves)
+    * \param [in] node - номер узла
+    * \return количество листьев без отметки в поддереве
+    */
+    int countUncoveredLeaves(int node) const;
+};
+
+#endif // SHAREDTREE_H
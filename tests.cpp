@@ -5,8 +5,39 @@
 
 #include "tests.h"
 #include <QString>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrent>
+#include <type_traits>
 #define NODE_PARENT_HASH QHash<Node*, int>
 #define REDUNDANT_NODES QSet<QPair<Node*, Node*>>
+#define COMPONENT_NAMES QList<QStringList>
+#define COMPONENT_ERRORS QList<QList<Error>>
+#define NAME_PAIRS QList<QPair<QString, QString>>
+
+/*!
+ * \brief Список вариантов CoverageEngine, для каждого из которого выполняется проверка
+ */
+template <typename... Engines>
+struct EngineList {
+    template <typename Check>
+    static void forEach(Check check) {
+        (check(static_cast<Engines*>(nullptr)), ...);
+    }
+};
+
+/*!
+ * \brief Все сочетания стратегий хранения дерева, множеств и обхода
+ */
+typedef EngineList<CoverageEngine<PointerTreePolicy, HashSetPolicy, RecursiveTraversal>,
+                   CoverageEngine<PointerTreePolicy, HashSetPolicy, IterativeTraversal>,
+                   CoverageEngine<PointerTreePolicy, BitSetPolicy, RecursiveTraversal>,
+                   CoverageEngine<PointerTreePolicy, BitSetPolicy, IterativeTraversal>,
+                   CoverageEngine<FlatTreePolicy, HashSetPolicy, RecursiveTraversal>,
+                   CoverageEngine<FlatTreePolicy, HashSetPolicy, IterativeTraversal>,
+                   CoverageEngine<FlatTreePolicy, BitSetPolicy, RecursiveTraversal>,
+                   CoverageEngine<FlatTreePolicy, BitSetPolicy, IterativeTraversal>> AllCoverageEngines;
 
 void Tests::printNodeSetDifference(const QSet<Node*>& actual, const QSet<Node*>& expected) {
     QSet<Node*> extraInActual = actual - expected; // Узлы которые есть в контейнере после вызова метода, но нет в ожидаемом контейнере
@@ -172,6 +203,21 @@ bool Tests::compareNodes(QPair<const Node*, const Node*> pair, QSet<QPair<const
     return true;
 }
 
+void Tests::prepareAnalyzer(const QString& content, TreeCoverageAnalyzer& analyzer) {
+    analyzer.parseDOT(content);
+    analyzer.fillHash(analyzer.treeMap, analyzer.amountOfParents);
+    analyzer.computeSubtreeHashes();
+}
+
+QStringList Tests::sortedNames(const QSet<Node*>& nodes) {
+    QStringList names;
+    for (Node* node : nodes) {
+        names.append(node->name);
+    }
+    names.sort();
+    return names;
+}
+
 void Tests::parseDOT_test() {
     QFETCH(QString, content);
     QFETCH(bool, shouldSucceed);
@@ -2270,3 +2316,2014 @@ void Tests::analyzeZoneWithRedundant_test_data(){
                                                       << a;
     }
 }
+
+void Tests::splitIntoComponents_test(){
+    QFETCH(QString, content);
+    QFETCH(COMPONENT_NAMES, expectedComponents);
+
+    TreeCoverageAnalyzer analyzer;
+    analyzer.parseDOT(content);
+
+    // Вызов метода
+    QList<QList<Node*>> components = analyzer.splitIntoComponents();
+
+    // Переводим компоненты в имена узлов
+    QList<QStringList> actualComponents;
+    for (const QList<Node*>& component : components) {
+        QStringList names;
+        for (Node* node : component) {
+            names.append(node->name);
+        }
+        actualComponents.append(names);
+    }
+
+    // Проверка результатов
+    QCOMPARE(actualComponents, expectedComponents);
+
+    // Очистка
+    analyzer.clearData();
+}
+void Tests::splitIntoComponents_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<COMPONENT_NAMES>("expectedComponents");
+
+    // Тест 1: Граф состоящий из одного дерева
+    {
+        QTest::newRow("OneTree") << "digraph test {\n"
+                                    "a[shape=square];\n"
+                                    "b[shape=diamond];\n"
+                                    "a->b;\n"
+                                    "a->c;\n"
+                                    "}"
+                                 << (QList<QStringList>{{"a", "b", "c"}});
+    }
+
+    // Тест 2: Два независимых дерева
+    {
+        QTest::newRow("TwoTrees") << "digraph test {\n"
+                                     "a[shape=square];\n"
+                                     "d[shape=square];\n"
+                                     "a->b;\n"
+                                     "d->e;\n"
+                                     "e->c;\n"
+                                     "}"
+                                  << (QList<QStringList>{{"a", "b"}, {"c", "d", "e"}});
+    }
+
+    // Тест 3: Компоненту связывает узел с двумя родителями
+    {
+        QTest::newRow("ComponentJoinedByMultiParent") << "digraph test {\n"
+                                                         "a[shape=square];\n"
+                                                         "a->c;\n"
+                                                         "b->c;\n"
+                                                         "d;\n"
+                                                         "}"
+                                                      << (QList<QStringList>{{"a", "b", "c"}, {"d"}});
+    }
+
+    // Тест 4: Компонента из цикла без корня
+    {
+        QTest::newRow("CycleComponent") << "digraph test {\n"
+                                           "a[shape=square];\n"
+                                           "a->b;\n"
+                                           "c->d;\n"
+                                           "d->c;\n"
+                                           "}"
+                                        << (QList<QStringList>{{"a", "b"}, {"c", "d"}});
+    }
+}
+
+void Tests::analyzeForest_test(){
+    QFETCH(QString, content);
+    QFETCH(QStringList, expectedRoots);
+    QFETCH(COMPONENT_NAMES, expectedMissingNodes);
+    QFETCH(COMPONENT_NAMES, expectedExtraNodes);
+    QFETCH(COMPONENT_ERRORS, expectedErrors);
+
+    TreeCoverageAnalyzer analyzer;
+    analyzer.parseDOT(content);
+
+    // Вызов метода
+    analyzer.analyzeForest();
+
+    // Собираем результаты каждой компоненты
+    QStringList actualRoots;
+    QList<QStringList> actualMissingNodes;
+    QList<QStringList> actualExtraNodes;
+    QList<QList<Error>> actualErrors;
+    for (const TreeCoverageAnalyzer* component : analyzer.forest) {
+        QStringList rootNames;
+        for (Node* root : component->rootNodes) {
+            rootNames.append(root->name);
+        }
+        rootNames.sort();
+        actualRoots.append(rootNames.join(' '));
+
+        QStringList missingNames;
+        for (Node* node : component->missingNodes) {
+            missingNames.append(node->name);
+        }
+        missingNames.sort();
+        actualMissingNodes.append(missingNames);
+
+        QStringList extraNames;
+        for (Node* node : component->extraNodes) {
+            extraNames.append(node->name);
+        }
+        extraNames.sort();
+        actualExtraNodes.append(extraNames);
+
+        actualErrors.append(component->errors);
+    }
+
+    // Проверка результатов
+    QCOMPARE(actualRoots, expectedRoots);
+    QCOMPARE(actualMissingNodes, expectedMissingNodes);
+    QCOMPARE(actualExtraNodes, expectedExtraNodes);
+    QCOMPARE(actualErrors, expectedErrors);
+
+    // Очистка
+    analyzer.clearData();
+}
+void Tests::analyzeForest_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QStringList>("expectedRoots");
+    QTest::addColumn<COMPONENT_NAMES>("expectedMissingNodes");
+    QTest::addColumn<COMPONENT_NAMES>("expectedExtraNodes");
+    QTest::addColumn<COMPONENT_ERRORS>("expectedErrors");
+
+    // Тест 1: Два покрытых дерева
+    {
+        QTest::newRow("TwoCoveredTrees") << "digraph test {\n"
+                                            "a[shape=square];\n"
+                                            "b[shape=diamond];\n"
+                                            "c[shape=square];\n"
+                                            "d[shape=diamond];\n"
+                                            "a->b;\n"
+                                            "c->d;\n"
+                                            "}"
+                                         << (QStringList{"a", "c"})
+                                         << (QList<QStringList>{{}, {}})
+                                         << (QList<QStringList>{{}, {}})
+                                         << (QList<QList<Error>>{{}, {}});
+    }
+
+    // Тест 2: В одном дереве не хватает узлов, в другом есть лишний узел
+    {
+        QTest::newRow("MissingAndExtraInDifferentTrees") << "digraph test {\n"
+                                                            "a[shape=square];\n"
+                                                            "b[shape=diamond];\n"
+                                                            "e[shape=diamond];\n"
+                                                            "f[shape=square];\n"
+                                                            "a->b;\n"
+                                                            "a->c;\n"
+                                                            "e->f;\n"
+                                                            "f->g;\n"
+                                                            "}"
+                                                         << (QStringList{"a", "e"})
+                                                         << (QList<QStringList>{{"c"}, {"g"}})
+                                                         << (QList<QStringList>{{}, {"e"}})
+                                                         << (QList<QList<Error>>{{}, {}});
+    }
+
+    // Тест 3: Компонента без целевого узла и компонента с циклом
+    {
+        QTest::newRow("InvalidComponents") << "digraph test {\n"
+                                              "a[shape=square];\n"
+                                              "b[shape=diamond];\n"
+                                              "c[shape=diamond];\n"
+                                              "a->b;\n"
+                                              "c->d;\n"
+                                              "e[shape=square];\n"
+                                              "e->f;\n"
+                                              "f->g;\n"
+                                              "g->f;\n"
+                                              "}"
+                                           << (QStringList{"a", "c", "e"})
+                                           << (QList<QStringList>{{}, {}, {}})
+                                           << (QList<QStringList>{{}, {}, {}})
+                                           << (QList<QList<Error>>{{}, {Error(Error::NoTargetNode)}, {Error(Error::MultiParents), Error(Error::Cycle)}});
+    }
+}
+
+void Tests::diffWith_test(){
+    QFETCH(QString, previousContent);
+    QFETCH(QString, content);
+    QFETCH(QStringList, expectedChangedNodes);
+    QFETCH(QStringList, expectedAddedNodes);
+    QFETCH(QStringList, expectedRemovedNodes);
+    QFETCH(int, expectedReusedSubtrees);
+
+    // Предыдущая ревизия анализируется полностью
+    TreeCoverageAnalyzer previous;
+    prepareAnalyzer(previousContent, previous);
+    QVERIFY(previous.errors.isEmpty());
+    previous.analyzeZoneWithExtraNodes(*previous.rootNodes.begin());
+
+    // Эталон: полный анализ текущей ревизии
+    TreeCoverageAnalyzer reference;
+    prepareAnalyzer(content, reference);
+    QVERIFY(reference.errors.isEmpty());
+    reference.analyzeZoneWithExtraNodes(*reference.rootNodes.begin());
+
+    // Снимок предыдущей ревизии проходит через файл, как между запусками с --save-state и --diff
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QVERIFY(RevisionState::fromAnalyzer(previous).write(directory.filePath("previous.state")));
+    RevisionState previousState;
+    QVERIFY(previousState.read(directory.filePath("previous.state")));
+    QCOMPARE(previousState.size(), previous.treeMap.size());
+
+    // Вызов метода и анализ с переиспользованием результатов
+    TreeCoverageAnalyzer analyzer;
+    prepareAnalyzer(content, analyzer);
+    analyzer.diffWith(previousState);
+    analyzer.analyzeZoneWithExtraNodes(*analyzer.rootNodes.begin());
+
+    QStringList changedNames;
+    for (Node* node : analyzer.changedNodes) {
+        changedNames.append(node->name);
+    }
+    QStringList addedNames;
+    for (Node* node : analyzer.addedNodes) {
+        addedNames.append(node->name);
+    }
+
+    // Проверка результатов
+    QCOMPARE(changedNames, expectedChangedNodes);
+    QCOMPARE(addedNames, expectedAddedNodes);
+    QCOMPARE(analyzer.removedNodeNames, expectedRemovedNodes);
+    QCOMPARE(analyzer.reusedSubtreeCount, expectedReusedSubtrees);
+    QCOMPARE(sortedNames(analyzer.missingNodes), sortedNames(reference.missingNodes));
+    QCOMPARE(sortedNames(analyzer.extraNodes), sortedNames(reference.extraNodes));
+    QCOMPARE(analyzer.redundantNodes.size(), reference.redundantNodes.size());
+
+    // Статусы узлов внутри переиспользованных поддеревьев восстанавливаются по запросу и совпадают с полным анализом
+    analyzer.resolveReusedStatuses();
+    QMap<QString, int> statuses;
+    for (auto it = analyzer.nodeStatuses.constBegin(); it != analyzer.nodeStatuses.constEnd(); ++it) {
+        statuses[it.key()->name] = it.value();
+    }
+    QMap<QString, int> referenceStatuses;
+    for (auto it = reference.nodeStatuses.constBegin(); it != reference.nodeStatuses.constEnd(); ++it) {
+        referenceStatuses[it.key()->name] = it.value();
+    }
+    QCOMPARE(statuses, referenceStatuses);
+
+    // Очистка
+    analyzer.clearData();
+    reference.clearData();
+    previous.clearData();
+}
+void Tests::diffWith_test_data(){
+    QTest::addColumn<QString>("previousContent");
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QStringList>("expectedChangedNodes");
+    QTest::addColumn<QStringList>("expectedAddedNodes");
+    QTest::addColumn<QStringList>("expectedRemovedNodes");
+    QTest::addColumn<int>("expectedReusedSubtrees");
+
+    const QString baseTree = "digraph test {\n"
+                             "a[shape=square];\n"
+                             "d[shape=diamond];\n"
+                             "a->b;\n"
+                             "a->c;\n"
+                             "b->d;\n"
+                             "b->e;\n"
+                             "}";
+
+    // Тест 1: Дерево не изменилось, переиспользуется все поддерево целевого узла
+    {
+        QTest::newRow("SameTree") << baseTree
+                                  << baseTree
+                                  << QStringList()
+                                  << QStringList()
+                                  << QStringList()
+                                  << 1;
+    }
+
+    // Тест 2: Изменилась форма одного листа
+    {
+        QTest::newRow("ChangedLeafShape") << baseTree
+                                          << "digraph test {\n"
+                                             "a[shape=square];\n"
+                                             "d[shape=diamond];\n"
+                                             "e[shape=diamond];\n"
+                                             "a->b;\n"
+                                             "a->c;\n"
+                                             "b->d;\n"
+                                             "b->e;\n"
+                                             "}"
+                                          << (QStringList{"e"})
+                                          << QStringList()
+                                          << QStringList()
+                                          << 2;
+    }
+
+    // Тест 3: Лист заменен другим узлом
+    {
+        QTest::newRow("ReplacedLeaf") << baseTree
+                                      << "digraph test {\n"
+                                         "a[shape=square];\n"
+                                         "d[shape=diamond];\n"
+                                         "a->b;\n"
+                                         "a->c;\n"
+                                         "b->d;\n"
+                                         "b->f;\n"
+                                         "}"
+                                      << (QStringList{"b"})
+                                      << (QStringList{"f"})
+                                      << (QStringList{"e"})
+                                      << 2;
+    }
+
+    // Тест 4: Избыточные узлы внутри неизменного поддерева
+    {
+        QTest::newRow("RedundantInsideUnchangedSubtree") << "digraph test {\n"
+                                                            "a[shape=square];\n"
+                                                            "b[shape=diamond];\n"
+                                                            "d[shape=diamond];\n"
+                                                            "a->b;\n"
+                                                            "a->c;\n"
+                                                            "b->d;\n"
+                                                            "}"
+                                                         << "digraph test {\n"
+                                                            "a[shape=square];\n"
+                                                            "b[shape=diamond];\n"
+                                                            "c[shape=diamond];\n"
+                                                            "d[shape=diamond];\n"
+                                                            "a->b;\n"
+                                                            "a->c;\n"
+                                                            "b->d;\n"
+                                                            "}"
+                                                         << (QStringList{"c"})
+                                                         << QStringList()
+                                                         << QStringList()
+                                                         << 1;
+    }
+}
+
+void Tests::suggestMarks_test(){
+    QFETCH(QString, content);
+    QFETCH(int, k);
+    QFETCH(QStringList, expectedSuggestions);
+
+    TreeCoverageAnalyzer analyzer;
+    prepareAnalyzer(content, analyzer);
+    QVERIFY(analyzer.errors.isEmpty());
+    analyzer.analyzeZoneWithExtraNodes(*analyzer.rootNodes.begin());
+
+    // Вызов метода
+    QList<QPair<Node*, int>> suggestions = analyzer.suggestMarks(k);
+
+    QStringList actualSuggestions;
+    for (const QPair<Node*, int>& suggestion : suggestions) {
+        actualSuggestions.append(QString("%1:%2").arg(suggestion.first->name).arg(suggestion.second));
+    }
+
+    // Проверка результатов
+    QCOMPARE(actualSuggestions, expectedSuggestions);
+
+    // Очистка
+    analyzer.clearData();
+}
+void Tests::suggestMarks_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<int>("k");
+    QTest::addColumn<QStringList>("expectedSuggestions");
+
+    const QString tree = "digraph test {\n"
+                         "a[shape=square];\n"
+                         "f[shape=diamond];\n"
+                         "a->b;\n"
+                         "a->c;\n"
+                         "a->d;\n"
+                         "b->e;\n"
+                         "b->f;\n"
+                         "c->g;\n"
+                         "c->h;\n"
+                         "c->i;\n"
+                         "d->j;\n"
+                         "d->k;\n"
+                         "}";
+
+    // Тест 1: Целевой узел покрыт, предлагать нечего
+    {
+        QTest::newRow("NothingToSuggest") << "digraph test {\n"
+                                             "a[shape=square];\n"
+                                             "b[shape=diamond];\n"
+                                             "a->b;\n"
+                                             "}"
+                                          << 3
+                                          << QStringList();
+    }
+
+    // Тест 2: Лучший кандидат по количеству покрываемых листьев
+    {
+        QTest::newRow("BestCandidate") << tree
+                                       << 1
+                                       << (QStringList{"c:3"});
+    }
+
+    // Тест 3: При равном приросте узлы упорядочены по имени
+    {
+        QTest::newRow("TiesOrderedByName") << tree
+                                           << 3
+                                           << (QStringList{"c:3", "d:2", "e:1"});
+    }
+
+    // Тест 4: k больше количества недостающих узлов
+    {
+        QTest::newRow("KGreaterThanMissing") << tree
+                                             << 10
+                                             << (QStringList{"c:3", "d:2", "e:1"});
+    }
+}
+
+void Tests::coverageExporter_test(){
+    QFETCH(QString, content);
+    QFETCH(QList<int>, expectedParents);
+    QFETCH(QList<int>, expectedDepths);
+    QFETCH(QList<int>, expectedShapes);
+    QFETCH(QList<int>, expectedStatuses);
+
+    TreeCoverageAnalyzer analyzer;
+    prepareAnalyzer(content, analyzer);
+    QVERIFY(analyzer.errors.isEmpty());
+    analyzer.analyzeZoneWithExtraNodes(*analyzer.rootNodes.begin());
+
+    // Вызов метода
+    CoverageExporter exporter(analyzer);
+
+    QList<int> actualParents(exporter.parents.begin(), exporter.parents.end());
+    QList<int> actualDepths(exporter.depths.begin(), exporter.depths.end());
+    QList<int> actualShapes(exporter.shapes.begin(), exporter.shapes.end());
+    QList<int> actualStatuses(exporter.statuses.begin(), exporter.statuses.end());
+
+    // Проверка результатов
+    QCOMPARE(actualParents, expectedParents);
+    QCOMPARE(actualDepths, expectedDepths);
+    QCOMPARE(actualShapes, expectedShapes);
+    QCOMPARE(actualStatuses, expectedStatuses);
+    QCOMPARE(exporter.nameOffsets.size(), analyzer.treeMap.size() + 1);
+    for (int row = 0; row < analyzer.treeMap.size(); ++row) {
+        const qint64 offset = exporter.nameOffsets[row];
+        const qint64 length = exporter.nameOffsets[row + 1] - offset;
+        QCOMPARE(QString::fromUtf8(exporter.names.mid(offset, length)), analyzer.treeMap[row]->name);
+    }
+
+    // Очистка
+    analyzer.clearData();
+}
+void Tests::coverageExporter_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QList<int>>("expectedParents");
+    QTest::addColumn<QList<int>>("expectedDepths");
+    QTest::addColumn<QList<int>>("expectedShapes");
+    QTest::addColumn<QList<int>>("expectedStatuses");
+
+    // Тест 1: Дерево с непокрытой веткой
+    {
+        QTest::newRow("TreeWithMissingBranch") << "digraph test {\n"
+                                                  "a[shape=square];\n"
+                                                  "b[shape=diamond];\n"
+                                                  "a->b;\n"
+                                                  "a->c;\n"
+                                                  "c->d;\n"
+                                                  "}"
+                                               << (QList<int>{-1, 0, 0, 2})
+                                               << (QList<int>{0, 1, 1, 2})
+                                               << (QList<int>{Node::Target, Node::Selected, Node::Base, Node::Base})
+                                               << (QList<int>{TreeCoverageAnalyzer::PartiallyCovered, TreeCoverageAnalyzer::FullyCovered,
+                                                              TreeCoverageAnalyzer::NotCovered, TreeCoverageAnalyzer::NotCovered});
+    }
+
+    // Тест 2: Узлы выше целевого и под отмеченным узлом не получают статус
+    {
+        QTest::newRow("NodesOutsideMissingZone") << "digraph test {\n"
+                                                    "b[shape=square];\n"
+                                                    "c[shape=diamond];\n"
+                                                    "a->b;\n"
+                                                    "b->c;\n"
+                                                    "c->d;\n"
+                                                    "}"
+                                                 << (QList<int>{3, 0, 1, -1})
+                                                 << (QList<int>{1, 2, 3, 0})
+                                                 << (QList<int>{Node::Target, Node::Selected, Node::Base, Node::Base})
+                                                 << (QList<int>{TreeCoverageAnalyzer::FullyCovered, TreeCoverageAnalyzer::FullyCovered,
+                                                                CoverageExporter::NoValue, CoverageExporter::NoValue});
+    }
+}
+
+void Tests::writeResult_test(){
+    QFETCH(QString, content);
+    QFETCH(QString, expectedResult);
+
+    TreeCoverageAnalyzer analyzer;
+    prepareAnalyzer(content, analyzer);
+    QVERIFY(analyzer.errors.isEmpty());
+    analyzer.analyzeZoneWithExtraNodes(*analyzer.rootNodes.begin());
+
+    // Вызов метода
+    QString result;
+    QTextStream out(&result);
+    analyzer.writeResult(out);
+    out.flush();
+
+    // Проверка результатов
+    QCOMPARE(result, expectedResult);
+
+    // Очистка
+    analyzer.clearData();
+}
+void Tests::writeResult_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QString>("expectedResult");
+
+    // Тест 1: Отмеченные узлы покрывают целевой
+    {
+        QTest::newRow("SelectedNodesCoverTarget") << "digraph test {\n"
+                                                     "a[shape=square];\n"
+                                                     "b[shape=diamond];\n"
+                                                     "c[shape=diamond];\n"
+                                                     "a->b;\n"
+                                                     "a->c;\n"
+                                                     "}"
+                                                  << "Помеченные узлы b c покрывают вышележащий узел a.\n";
+    }
+
+    // Тест 2: Не хватает одного узла
+    {
+        QTest::newRow("OneMissingNode") << "digraph test {\n"
+                                           "a[shape=square];\n"
+                                           "b[shape=diamond];\n"
+                                           "a->b;\n"
+                                           "a->c;\n"
+                                           "}"
+                                        << "Узел a – не покрыт, следует отметить узлы c для того чтобы узел a стал покрытым.\n";
+    }
+
+    // Тест 3: Отмеченный узел выше целевого
+    {
+        QTest::newRow("OneExtraNode") << "digraph test {\n"
+                                         "a[shape=diamond];\n"
+                                         "b[shape=square];\n"
+                                         "c[shape=diamond];\n"
+                                         "a->b;\n"
+                                         "b->c;\n"
+                                         "}"
+                                      << "Отмеченный узел a не является потомком целевого узла b.\n";
+    }
+}
+
+void Tests::writeJsonResult_test(){
+    QFETCH(QString, content);
+    QFETCH(QString, expectedResult);
+
+    TreeCoverageAnalyzer analyzer;
+    prepareAnalyzer(content, analyzer);
+    QVERIFY(analyzer.errors.isEmpty());
+    analyzer.analyzeZoneWithExtraNodes(*analyzer.rootNodes.begin());
+
+    // Вызов метода
+    QString result;
+    QTextStream out(&result);
+    JsonStreamWriter json(out);
+    json.beginObject();
+    analyzer.writeJsonResult(json);
+    json.endObject();
+    out.flush();
+
+    // Проверка результатов
+    QCOMPARE(result, expectedResult);
+
+    // Результат должен быть корректным JSON
+    QJsonParseError parseError;
+    QJsonDocument::fromJson(result.toUtf8(), &parseError);
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+
+    // Очистка
+    analyzer.clearData();
+}
+void Tests::writeJsonResult_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QString>("expectedResult");
+
+    // Тест 1: Целевой узел покрыт
+    {
+        QTest::newRow("Covered") << "digraph test {\n"
+                                    "a[shape=square];\n"
+                                    "b[shape=diamond];\n"
+                                    "a->b;\n"
+                                    "}"
+                                 << "{\"status\":\"ok\",\"errors\":[],\"targets\":[\"a\"],\"selected\":[\"b\"],"
+                                    "\"extra\":[],\"redundant\":[],\"missing\":[],\"covered\":true}";
+    }
+
+    // Тест 2: Недостающие и избыточные узлы перечислены в порядке treeMap
+    {
+        QTest::newRow("MissingAndRedundantInTreeOrder") << "digraph test {\n"
+                                                           "a[shape=square];\n"
+                                                           "b[shape=diamond];\n"
+                                                           "f[shape=diamond];\n"
+                                                           "g[shape=diamond];\n"
+                                                           "a->b;\n"
+                                                           "a->e;\n"
+                                                           "a->d;\n"
+                                                           "a->c;\n"
+                                                           "b->g;\n"
+                                                           "b->f;\n"
+                                                           "}"
+                                                        << "{\"status\":\"ok\",\"errors\":[],\"targets\":[\"a\"],\"selected\":[\"b\",\"f\",\"g\"],"
+                                                           "\"extra\":[],\"redundant\":[{\"ancestor\":\"b\",\"node\":\"f\"},{\"ancestor\":\"b\",\"node\":\"g\"}],"
+                                                           "\"missing\":[\"c\",\"d\",\"e\"],\"covered\":false}";
+    }
+}
+
+void Tests::analyze_test(){
+    QFETCH(QString, content);
+    QFETCH(CoverageResult::Status, expectedStatus);
+    QFETCH(QList<Error>, expectedErrors);
+    QFETCH(QStringList, expectedExtraNodes);
+    QFETCH(QStringList, expectedMissingNodes);
+    QFETCH(NAME_PAIRS, expectedRedundantNodes);
+
+    // Вызов метода, результат не должен зависеть от времени жизни анализатора
+    CoverageResult result;
+    {
+        TreeCoverageAnalyzer analyzer;
+        result = analyzer.analyzeBuffer(content.toUtf8());
+    }
+
+    // Проверка результатов
+    QCOMPARE(result.status, expectedStatus);
+    QCOMPARE(result.errors, expectedErrors);
+    QCOMPARE(result.extraNodes, expectedExtraNodes);
+    QCOMPARE(result.missingNodes, expectedMissingNodes);
+    QCOMPARE(result.redundantNodes, expectedRedundantNodes);
+}
+void Tests::analyze_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<CoverageResult::Status>("expectedStatus");
+    QTest::addColumn<QList<Error>>("expectedErrors");
+    QTest::addColumn<QStringList>("expectedExtraNodes");
+    QTest::addColumn<QStringList>("expectedMissingNodes");
+    QTest::addColumn<NAME_PAIRS>("expectedRedundantNodes");
+
+    // Тест 1: Ошибка парсинга не завершает программу
+    {
+        QTest::newRow("ParseErrors") << ""
+                                     << CoverageResult::ParseErrors
+                                     << (QList<Error>{Error(Error::EmptyFile)})
+                                     << QStringList()
+                                     << QStringList()
+                                     << QList<QPair<QString, QString>>();
+    }
+
+    // Тест 2: Граф не является деревом
+    {
+        QTest::newRow("GraphErrors") << "digraph test {\n"
+                                        "a[shape=square];\n"
+                                        "a->b;\n"
+                                        "c->d;\n"
+                                        "}"
+                                     << CoverageResult::GraphErrors
+                                     << (QList<Error>{Error(Error::DisconnectedGraph)})
+                                     << QStringList()
+                                     << QStringList()
+                                     << QList<QPair<QString, QString>>();
+    }
+
+    // Тест 3: Целевой узел покрыт
+    {
+        QTest::newRow("Covered") << "digraph test {\n"
+                                    "a[shape=square];\n"
+                                    "b[shape=diamond];\n"
+                                    "a->b;\n"
+                                    "}"
+                                 << CoverageResult::Covered
+                                 << QList<Error>()
+                                 << QStringList()
+                                 << QStringList()
+                                 << QList<QPair<QString, QString>>();
+    }
+
+    // Тест 4: Все виды замечаний
+    {
+        QTest::newRow("NotCovered") << "digraph test {\n"
+                                       "r[shape=diamond];\n"
+                                       "a[shape=square];\n"
+                                       "b[shape=diamond];\n"
+                                       "c[shape=diamond];\n"
+                                       "r->a;\n"
+                                       "a->b;\n"
+                                       "a->d;\n"
+                                       "b->c;\n"
+                                       "}"
+                                    << CoverageResult::NotCovered
+                                    << QList<Error>()
+                                    << (QStringList{"r"})
+                                    << (QStringList{"d"})
+                                    << (QList<QPair<QString, QString>>{qMakePair(QString("b"), QString("c"))});
+    }
+}
+
+void Tests::batchAnalyzer_test(){
+    QFETCH(QStringList, fileNames);
+    QFETCH(QStringList, contents);
+    QFETCH(int, threadCount);
+    QFETCH(bool, isPipelined);
+    QFETCH(QStringList, expectedResultFiles);
+    QFETCH(QStringList, expectedStatuses);
+
+    // Подготовка входных файлов во временном каталоге
+    QTemporaryDir inputDirectory;
+    QTemporaryDir outputDirectory;
+    QVERIFY(inputDirectory.isValid() && outputDirectory.isValid());
+    for (int i = 0; i < fileNames.size(); ++i) {
+        QDir().mkpath(QFileInfo(inputDirectory.filePath(fileNames[i])).path());
+        QFile file(inputDirectory.filePath(fileNames[i]));
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+        file.write(contents[i].toUtf8());
+        file.close();
+    }
+
+    // Вызов метода, файлы передаются списком в заданном порядке
+    BatchAnalyzer batch;
+    batch.threadCount = threadCount;
+    batch.isPipelined = isPipelined;
+    batch.queueCapacity = 2;
+    batch.outputDirectory = outputDirectory.path();
+    for (const QString& fileName : fileNames) {
+        batch.inputFiles.append(inputDirectory.filePath(fileName));
+    }
+    batch.inputFiles.append(inputDirectory.filePath("absent.dot"));
+    QVERIFY(batch.run());
+
+    // Проверка результатов: строки таблицы идут в порядке входных файлов, отсутствующий файл не прерывает пакет
+    QFile summaryFile(outputDirectory.filePath("summary.csv"));
+    QVERIFY(summaryFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    QStringList lines = QString::fromUtf8(summaryFile.readAll()).split('\n', Qt::SkipEmptyParts);
+    QCOMPARE(lines.size(), fileNames.size() + 2);
+    QStringList statuses;
+    for (int i = 1; i < lines.size(); ++i) {
+        statuses.append(lines[i].section(',', 2, 2));
+    }
+    QCOMPARE(statuses, expectedStatuses + QStringList{"ReadError"});
+    QCOMPARE(batch.failedCount, 1);
+    for (const QString& resultFile : expectedResultFiles) {
+        QVERIFY2(QFile::exists(outputDirectory.filePath(resultFile)), qPrintable(resultFile));
+    }
+}
+void Tests::batchAnalyzer_test_data(){
+    QTest::addColumn<QStringList>("fileNames");
+    QTest::addColumn<QStringList>("contents");
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("isPipelined");
+    QTest::addColumn<QStringList>("expectedResultFiles");
+    QTest::addColumn<QStringList>("expectedStatuses");
+
+    const QString covered = "digraph test {\n"
+                            "a[shape=square];\n"
+                            "b[shape=diamond];\n"
+                            "a->b;\n"
+                            "}";
+    const QString notCovered = "digraph test {\n"
+                               "a[shape=square];\n"
+                               "a->b;\n"
+                               "}";
+
+    // Тест 1: Один поток, все итоги анализа
+    {
+        QTest::newRow("SingleThread") << (QStringList{"covered.dot", "missing.dot", "empty.dot"})
+                                      << (QStringList{covered, notCovered, ""})
+                                      << 1
+                                      << false
+                                      << (QStringList{"covered.txt", "missing.txt", "empty.txt"})
+                                      << (QStringList{"Covered", "NotCovered", "ParseErrors"});
+    }
+
+    // Тест 2: Порядок строк таблицы не зависит от порядка завершения потоков
+    {
+        QStringList fileNames, contents, resultFiles, statuses;
+        for (int i = 0; i < 32; ++i) {
+            fileNames.append(QString("tree%1.dot").arg(i));
+            contents.append(i % 2 == 0 ? covered : notCovered);
+            resultFiles.append(QString("tree%1.txt").arg(i));
+            statuses.append(i % 2 == 0 ? "Covered" : "NotCovered");
+        }
+        QTest::newRow("ManyThreads") << fileNames << contents << 4 << false << resultFiles << statuses;
+    }
+
+    // Тест 3: Одинаковые имена файлов из разных каталогов не перезаписывают результаты друг друга
+    {
+        QTest::newRow("SameBaseName") << (QStringList{"first/tree.dot", "second/tree.dot"})
+                                      << (QStringList{covered, notCovered})
+                                      << 2
+                                      << false
+                                      << (QStringList{"tree.txt", "tree_2.txt"})
+                                      << (QStringList{"Covered", "NotCovered"});
+    }
+
+    // Тест 4: Конвейер с одним потоком на стадию и очередями емкости 2
+    {
+        QTest::newRow("PipelineSingleThread") << (QStringList{"covered.dot", "missing.dot", "empty.dot"})
+                                              << (QStringList{covered, notCovered, ""})
+                                              << 1
+                                              << true
+                                              << (QStringList{"covered.txt", "missing.txt", "empty.txt"})
+                                              << (QStringList{"Covered", "NotCovered", "ParseErrors"});
+    }
+
+    // Тест 5: Конвейер сохраняет порядок строк таблицы при файлах больше емкости очередей
+    {
+        QStringList fileNames, contents, resultFiles, statuses;
+        for (int i = 0; i < 32; ++i) {
+            fileNames.append(QString("tree%1.dot").arg(i));
+            contents.append(i % 3 == 0 ? covered : notCovered);
+            resultFiles.append(QString("tree%1.txt").arg(i));
+            statuses.append(i % 3 == 0 ? "Covered" : "NotCovered");
+        }
+        QTest::newRow("PipelineManyThreads") << fileNames << contents << 4 << true << resultFiles << statuses;
+    }
+}
+
+void Tests::coverageDaemon_test(){
+    QFETCH(QString, content);
+    QFETCH(QString, changedContent);
+    QFETCH(QStringList, requests);
+    QFETCH(QStringList, expectedResponses);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString path = directory.filePath("tree.dot");
+    auto writeTree = [&](const QString& treeContent, const QDateTime& modified) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+        file.write(treeContent.toUtf8());
+        QVERIFY(file.setFileTime(modified, QFileDevice::FileModificationTime));
+        file.close();
+    };
+    const QDateTime modified = QDateTime::currentDateTime().addSecs(-60);
+    writeTree(content, modified);
+
+    // Вызов метода для каждой команды сеанса, команда CHANGE меняет файл и время его модификации
+    CoverageDaemon daemon;
+    CoverageDaemon::Session session;
+    QStringList responses;
+    for (const QString& request : requests) {
+        if (request == "CHANGE") {
+            writeTree(changedContent, modified.addSecs(30));
+            continue;
+        }
+        responses.append(QString::fromUtf8(daemon.handleRequest(session, QString(request).replace("%path", path))));
+    }
+
+    // Проверка результатов
+    QCOMPARE(responses, expectedResponses);
+}
+void Tests::coverageDaemon_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QString>("changedContent");
+    QTest::addColumn<QStringList>("requests");
+    QTest::addColumn<QStringList>("expectedResponses");
+
+    auto result = [](const QString& payload) {
+        return QString("OK %1\n").arg(payload.toUtf8().size()) + payload;
+    };
+    const QString tree = "digraph test {\n"
+                         "a[shape=square];\n"
+                         "b[shape=diamond];\n"
+                         "a->b;\n"
+                         "a->c;\n"
+                         "}";
+
+    // Тест 1: Результат по отметкам файла, затем по отметкам сеанса без повторной загрузки
+    {
+        QTest::newRow("SelectWithoutReload") << tree << QString()
+                                             << (QStringList{"LOAD %path", "RESULT", "SELECT b,c", "RESULT", "SELECT", "RESULT"})
+                                             << (QStringList{"OK 3\n",
+                                                             result("Узел a – не покрыт, следует отметить узлы c для того чтобы узел a стал покрытым.\n"),
+                                                             "OK 2\n",
+                                                             result("Помеченные узлы b c покрывают вышележащий узел a.\n"),
+                                                             "OK 0\n",
+                                                             result("Узел a – не покрыт, следует отметить узлы b c для того чтобы узел a стал покрытым.\n")});
+    }
+
+    // Тест 2: Ошибки команд не меняют состояние сеанса
+    {
+        QTest::newRow("RequestErrors") << tree << QString()
+                                       << (QStringList{"RESULT", "LOAD %path", "SELECT a", "SELECT x", "RESULT xml", "STOP", "RESULT"})
+                                       << (QStringList{"ERROR дерево не загружено\n",
+                                                       "OK 3\n",
+                                                       "ERROR нельзя отметить узлы: a\n",
+                                                       "ERROR нельзя отметить узлы: x\n",
+                                                       "ERROR неизвестный формат вывода xml\n",
+                                                       "ERROR неизвестная команда STOP\n",
+                                                       result("Узел a – не покрыт, следует отметить узлы c для того чтобы узел a стал покрытым.\n")});
+    }
+
+    // Тест 3: Измененный файл разбирается заново по времени модификации
+    {
+        QTest::newRow("ReloadChangedFile") << tree
+                                           << "digraph test {\n"
+                                              "a[shape=square];\n"
+                                              "b[shape=diamond];\n"
+                                              "a->b;\n"
+                                              "}"
+                                           << (QStringList{"LOAD %path", "RESULT", "CHANGE", "RESULT"})
+                                           << (QStringList{"OK 3\n",
+                                                           result("Узел a – не покрыт, следует отметить узлы c для того чтобы узел a стал покрытым.\n"),
+                                                           result("Помеченные узлы b покрывают вышележащий узел a.\n")});
+    }
+}
+
+void Tests::coverageWatcher_test(){
+    QFETCH(QStringList, contents);
+    QFETCH(QList<bool>, expectedSkipped);
+    QFETCH(QStringList, expectedResults);
+
+    // Вызов метода для каждой сохраненной версии файла
+    CoverageWatcher watcher;
+    QList<bool> skipped;
+    QStringList results;
+    for (const QString& content : contents) {
+        watcher.analyzeContent(content);
+        skipped.append(watcher.isValidationSkipped);
+        QString result;
+        QTextStream out(&result);
+        if (watcher.analyzer.errors.isEmpty()) {
+            watcher.analyzer.writeResult(out);
+        }
+        else {
+            out << "Ошибки: " << watcher.analyzer.errors.first().typeName() << "\n";
+        }
+        out.flush();
+        results.append(result);
+    }
+
+    // Проверка результатов
+    QCOMPARE(skipped, expectedSkipped);
+    QCOMPARE(results, expectedResults);
+}
+void Tests::coverageWatcher_test_data(){
+    QTest::addColumn<QStringList>("contents");
+    QTest::addColumn<QList<bool>>("expectedSkipped");
+    QTest::addColumn<QStringList>("expectedResults");
+
+    const QString missingC = "digraph test {\n"
+                             "a[shape=square];\n"
+                             "b[shape=diamond];\n"
+                             "c;\n"
+                             "a->b;\n"
+                             "a->c;\n"
+                             "}";
+    const QString covered = "digraph test {\n"
+                            "a[shape=square];\n"
+                            "b[shape=diamond];\n"
+                            "c[shape=diamond];\n"
+                            "a->b;\n"
+                            "a->c;\n"
+                            "}";
+    const QString newEdge = "digraph test {\n"
+                            "a[shape=square];\n"
+                            "b[shape=diamond];\n"
+                            "c[shape=diamond];\n"
+                            "a->b;\n"
+                            "a->c;\n"
+                            "c->d;\n"
+                            "}";
+    const QString multiParents = "digraph test {\n"
+                                 "a[shape=square];\n"
+                                 "b[shape=diamond];\n"
+                                 "c[shape=diamond];\n"
+                                 "a->b;\n"
+                                 "a->c;\n"
+                                 "b->c;\n"
+                                 "}";
+
+    // Тест 1: Изменились только атрибуты узлов
+    {
+        QTest::newRow("AttributesOnly") << (QStringList{missingC, covered, missingC})
+                                        << (QList<bool>{false, true, true})
+                                        << (QStringList{"Узел a – не покрыт, следует отметить узлы c для того чтобы узел a стал покрытым.\n",
+                                                        "Помеченные узлы b c покрывают вышележащий узел a.\n",
+                                                        "Узел a – не покрыт, следует отметить узлы c для того чтобы узел a стал покрытым.\n"});
+    }
+
+    // Тест 2: Новое ребро требует повторной проверки
+    {
+        QTest::newRow("StructureChanged") << (QStringList{covered, newEdge})
+                                          << (QList<bool>{false, false})
+                                          << (QStringList{"Помеченные узлы b c покрывают вышележащий узел a.\n",
+                                                          "Помеченные узлы b c покрывают вышележащий узел a.\n"});
+    }
+
+    // Тест 3: Дерево с ошибкой не считается проверенным, исправление снова проверяется
+    {
+        QTest::newRow("InvalidThenFixed") << (QStringList{multiParents, multiParents, covered})
+                                          << (QList<bool>{false, false, false})
+                                          << (QStringList{"Ошибки: MultiParents\n",
+                                                          "Ошибки: MultiParents\n",
+                                                          "Помеченные узлы b c покрывают вышележащий узел a.\n"});
+    }
+}
+
+void Tests::analyzeAsync_test(){
+    QFETCH(int, leafCount);
+    QFETCH(int, cancelStage);
+    QFETCH(CoverageResult::Status, expectedStatus);
+    QFETCH(int, expectedMissingCount);
+
+    // Звезда с целевым корнем: четные листья отмечены, нечетные не хватает для покрытия
+    QString content = "digraph test {\na[shape=square];\n";
+    for (int i = 0; i < leafCount; ++i) {
+        content += i % 2 == 0 ? QString("n%1[shape=diamond];\n").arg(i) : QString("n%1;\n").arg(i);
+    }
+    for (int i = 0; i < leafCount; ++i) {
+        content += QString("a->n%1;\n").arg(i);
+    }
+    content += "}";
+
+    CoverageResult result;
+    if (cancelStage < 0) {
+        // Вызов метода в пуле потоков, прогресс должен дойти до максимума
+        QFuture<CoverageResult> future = TreeCoverageAnalyzer::analyzeAsync(content);
+        future.waitForFinished();
+        result = future.result();
+        QCOMPARE(future.progressValue(), future.progressMaximum());
+    }
+    else {
+        // Обработчик прогресса отменяет анализ на заданной стадии
+        TreeCoverageAnalyzer analyzer;
+        QSet<int> reportedStages;
+        analyzer.progressHandler = [&](TreeCoverageAnalyzer::AnalysisStage stage, qint64 done, qint64 total) {
+            reportedStages.insert(stage);
+            return done <= total && stage != cancelStage;
+        };
+        result = analyzer.analyze(content);
+        QVERIFY(reportedStages.contains(cancelStage));
+        QVERIFY(!reportedStages.contains(cancelStage + 1));
+    }
+
+    // Проверка результатов
+    QCOMPARE(result.status, expectedStatus);
+    QCOMPARE(result.missingNodes.size(), expectedMissingCount);
+}
+void Tests::analyzeAsync_test_data(){
+    QTest::addColumn<int>("leafCount");
+    QTest::addColumn<int>("cancelStage");
+    QTest::addColumn<CoverageResult::Status>("expectedStatus");
+    QTest::addColumn<int>("expectedMissingCount");
+
+    // Тест 1: Анализ в пуле потоков без отмены
+    {
+        QTest::newRow("CompletedAsync") << 3000 << -1 << CoverageResult::NotCovered << 1500;
+    }
+
+    // Тест 2: Отмена во время разбора
+    {
+        QTest::newRow("CanceledWhileParsing") << 3000 << static_cast<int>(TreeCoverageAnalyzer::ParsingStage) << CoverageResult::Canceled << 0;
+    }
+
+    // Тест 3: Отмена во время проверки графа
+    {
+        QTest::newRow("CanceledWhileValidating") << 3000 << static_cast<int>(TreeCoverageAnalyzer::ValidationStage) << CoverageResult::Canceled << 0;
+    }
+
+    // Тест 4: Отмена во время анализа покрытия
+    {
+        QTest::newRow("CanceledWhileAnalyzing") << 3000 << static_cast<int>(TreeCoverageAnalyzer::CoverageStage) << CoverageResult::Canceled << 0;
+    }
+}
+
+void Tests::analyzeAsyncCancel_test(){
+    QFETCH(int, leafCount);
+
+    // Звезда с целевым корнем, разбор которой длится дольше, чем ожидание первого прогресса
+    QString content = "digraph test {\na[shape=square];\n";
+    for (int i = 0; i < leafCount; ++i) {
+        content += QString("a->n%1;\n").arg(i);
+    }
+    content += "}";
+
+    // Вызов метода и отмена будущего результата после первого сообщения о прогрессе
+    QFuture<CoverageResult> future = TreeCoverageAnalyzer::analyzeAsync(content);
+    while (!future.isFinished() && future.progressValue() == 0) {
+        QThread::msleep(1);
+    }
+    QVERIFY(!future.isFinished());
+    future.cancel();
+    future.waitForFinished();
+
+    // Проверка результатов: анализ прерван до конца, отмененный результат не содержит значения
+    QVERIFY(future.isCanceled());
+    QCOMPARE(future.resultCount(), 0);
+    QVERIFY(future.progressValue() < future.progressMaximum());
+}
+void Tests::analyzeAsyncCancel_test_data(){
+    QTest::addColumn<int>("leafCount");
+
+    // Тест 1: Отмена будущего результата во время работы в пуле потоков
+    {
+        QTest::newRow("CanceledFuture") << 300000;
+    }
+}
+
+void Tests::parseProgress_test(){
+    QFETCH(int, leafCount);
+    QFETCH(bool, isUndirected);
+    QFETCH(int, cancelPass);
+    QFETCH(int, expectedLastPass);
+    QFETCH(bool, expectedCanceled);
+
+    // Звезда с комментарием на кириллице, чтобы размер в байтах отличался от количества символов
+    QString content = "digraph test {\n// Корень и листья звезды\na[shape=square];\n";
+    for (int i = 0; i < leafCount; ++i) {
+        content += QString("n%1;\n").arg(i);
+    }
+    for (int i = 0; i < leafCount; ++i) {
+        content += QString(isUndirected ? "a--n%1;\n" : "a->n%1;\n").arg(i);
+    }
+    content += "}";
+    const qint64 inputBytes = content.toUtf8().size();
+
+    // Обработчик прогресса запоминает последний проход разбора и отменяет анализ на заданном проходе
+    TreeCoverageAnalyzer analyzer;
+    qint64 lastDone = 0;
+    int lastPass = -1;
+    bool isConsistent = true;
+    analyzer.progressHandler = [&](TreeCoverageAnalyzer::AnalysisStage stage, qint64 done, qint64 total) {
+        if (stage != TreeCoverageAnalyzer::ParsingStage) {
+            return true;
+        }
+        isConsistent = isConsistent && total == 3 * inputBytes && done >= lastDone && done <= total;
+        lastDone = done;
+        lastPass = static_cast<int>(qMin<qint64>(2, done / inputBytes));
+        return lastPass != cancelPass;
+    };
+    const CoverageResult result = analyzer.analyze(content);
+
+    // Проверка результатов
+    QVERIFY(isConsistent);
+    QCOMPARE(lastPass, expectedLastPass);
+    QCOMPARE(result.status == CoverageResult::Canceled, expectedCanceled);
+}
+void Tests::parseProgress_test_data(){
+    QTest::addColumn<int>("leafCount");
+    QTest::addColumn<bool>("isUndirected");
+    QTest::addColumn<int>("cancelPass");
+    QTest::addColumn<int>("expectedLastPass");
+    QTest::addColumn<bool>("expectedCanceled");
+
+    // Тест 1: Ориентированные ребра сообщают о прогрессе во втором проходе, третий проход совпадений не находит
+    {
+        QTest::newRow("DirectedEdges") << 3000 << false << -1 << 1 << false;
+    }
+
+    // Тест 2: Ненаправленные ребра сообщают о прогрессе в третьем проходе
+    {
+        QTest::newRow("UndirectedEdges") << 3000 << true << -1 << 2 << false;
+    }
+
+    // Тест 3: Отмена во время прохода по ненаправленным ребрам
+    {
+        QTest::newRow("CanceledWhileUndirected") << 3000 << true << 2 << 2 << true;
+    }
+}
+
+void Tests::resultCache_test(){
+    QFETCH(QStringList, contents);
+    QFETCH(bool, isPersistent);
+    QFETCH(int, expectedHitCount);
+    QFETCH(int, expectedMissCount);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString cacheDirectory = isPersistent ? directory.path() : QString();
+
+    // Вызов метода: каждый файл анализируется с кэшем и без него, при сохранении в каталог кэш создается заново
+    int hitCount = 0;
+    int missCount = 0;
+    ResultCache* cache = new ResultCache(2, cacheDirectory);
+    for (const QString& content : contents) {
+        if (isPersistent) {
+            hitCount += cache->hitCount;
+            missCount += cache->missCount;
+            delete cache;
+            cache = new ResultCache(2, cacheDirectory);
+        }
+        TreeCoverageAnalyzer cachedAnalyzer;
+        cachedAnalyzer.resultCache = cache;
+        const CoverageResult cachedResult = cachedAnalyzer.analyze(content);
+        TreeCoverageAnalyzer analyzer;
+        const CoverageResult result = analyzer.analyze(content);
+
+        // Результат из кэша совпадает с вычисленным, в том числе текстовый вывод по восстановленным узлам
+        QCOMPARE(cachedResult.status, result.status);
+        QCOMPARE(cachedResult.errors, result.errors);
+        QCOMPARE(cachedResult.extraNodes, result.extraNodes);
+        QCOMPARE(cachedResult.missingNodes, result.missingNodes);
+        QCOMPARE(cachedResult.redundantNodes, result.redundantNodes);
+        if (result.isValid()) {
+            QString cachedText, text;
+            QTextStream cachedOut(&cachedText), out(&text);
+            cachedAnalyzer.writeResult(cachedOut);
+            analyzer.writeResult(out);
+            cachedOut.flush();
+            out.flush();
+            QCOMPARE(cachedText, text);
+        }
+    }
+    hitCount += cache->hitCount;
+    missCount += cache->missCount;
+    delete cache;
+
+    // Проверка результатов
+    QCOMPARE(hitCount, expectedHitCount);
+    QCOMPARE(missCount, expectedMissCount);
+}
+void Tests::resultCache_test_data(){
+    QTest::addColumn<QStringList>("contents");
+    QTest::addColumn<bool>("isPersistent");
+    QTest::addColumn<int>("expectedHitCount");
+    QTest::addColumn<int>("expectedMissCount");
+
+    const QString missingC = "digraph test {\n"
+                             "a[shape=square];\n"
+                             "b[shape=diamond];\n"
+                             "c;\n"
+                             "a->b;\n"
+                             "a->c;\n"
+                             "}";
+    const QString covered = "digraph test {\n"
+                            "a[shape=square];\n"
+                            "b[shape=diamond];\n"
+                            "c[shape=diamond];\n"
+                            "a->b;\n"
+                            "a->c;\n"
+                            "}";
+    const QString redundant = "digraph test {\n"
+                              "a[shape=square];\n"
+                              "b[shape=diamond];\n"
+                              "c[shape=diamond];\n"
+                              "a->b;\n"
+                              "b->c;\n"
+                              "}";
+    const QString multiParents = "digraph test {\n"
+                                 "a[shape=square];\n"
+                                 "b[shape=diamond];\n"
+                                 "c[shape=diamond];\n"
+                                 "a->b;\n"
+                                 "a->c;\n"
+                                 "b->c;\n"
+                                 "}";
+
+    // Тест 1: Повторные пары (дерево, отметки) берутся из кэша, другие отметки того же дерева - нет
+    {
+        QTest::newRow("RepeatedSelection") << (QStringList{missingC, covered, missingC, covered})
+                                           << false << 2 << 2;
+    }
+
+    // Тест 2: Вытеснение давно не использованной записи при емкости 2
+    {
+        QTest::newRow("LeastRecentlyUsedEvicted") << (QStringList{missingC, covered, redundant, missingC})
+                                                  << false << 0 << 4;
+    }
+
+    // Тест 3: Ошибки графа тоже запоминаются
+    {
+        QTest::newRow("GraphErrors") << (QStringList{multiParents, multiParents})
+                                     << false << 1 << 1;
+    }
+
+    // Тест 4: Записи, сохраненные в каталог, находятся новым экземпляром кэша
+    {
+        QTest::newRow("Persistent") << (QStringList{missingC, redundant, missingC, redundant})
+                                    << true << 2 << 2;
+    }
+}
+
+void Tests::coverageEngineExtraZone_test(){
+    QFETCH(Node*, node);
+    QFETCH(QSet<Node*>, expectedExtraNodes);
+
+    // Вызов метода для каждого сочетания стратегий и проверка результатов
+    AllCoverageEngines::forEach([&](auto* engineType) {
+        typedef std::remove_pointer_t<decltype(engineType)> Engine;
+        Engine engine(QList<Node*>{node});
+        engine.analyzeZoneWithExtraNodes(node);
+        QCOMPARE(engine.nodeSet(engine.extraNodes), expectedExtraNodes);
+    });
+}
+void Tests::coverageEngineExtraZone_test_data(){
+    // Те же случаи, что и для TreeCoverageAnalyzer::analyzeZoneWithExtraNodes
+    analyzeZoneWithExtraNodes_test_data();
+}
+
+void Tests::coverageEngineMissingZone_test(){
+    QFETCH(Node*, node);
+    QFETCH(TreeCoverageAnalyzer::CoverageStatus, expectedCoverageStatus);
+    QFETCH(QSet<Node*>, expectedMissingNodes);
+
+    // Вызов метода для каждого сочетания стратегий и проверка результатов
+    AllCoverageEngines::forEach([&](auto* engineType) {
+        typedef std::remove_pointer_t<decltype(engineType)> Engine;
+        Engine engine(QList<Node*>{node});
+        const TreeCoverageAnalyzer::CoverageStatus status = engine.analyzeZoneWithMissingNodes(node);
+        QCOMPARE(status, expectedCoverageStatus);
+        QCOMPARE(engine.nodeSet(engine.missingNodes), expectedMissingNodes);
+    });
+}
+void Tests::coverageEngineMissingZone_test_data(){
+    // Те же случаи, что и для TreeCoverageAnalyzer::analyzeZoneWithMissingNodes
+    analyzeZoneWithMissingNodes_test_data();
+}
+
+void Tests::coverageEngineRedundantZone_test(){
+    QFETCH(Node*, node);
+    QFETCH(REDUNDANT_NODES, expectedRedundantNodes);
+    QFETCH(REDUNDANT_NODES, predefinedRedundantNodes);
+    QFETCH(Node*, selectedNode);
+
+    // Вызов метода для каждого сочетания стратегий, заранее заданные пары добавляются к найденным
+    AllCoverageEngines::forEach([&](auto* engineType) {
+        typedef std::remove_pointer_t<decltype(engineType)> Engine;
+        Engine engine(QList<Node*>{node, selectedNode});
+        engine.analyzeZoneWithRedundantNodes(node, selectedNode);
+        QCOMPARE(engine.redundantNodeSet() + predefinedRedundantNodes, expectedRedundantNodes);
+    });
+}
+void Tests::coverageEngineRedundantZone_test_data(){
+    // Те же случаи, что и для TreeCoverageAnalyzer::analyzeZoneWithRedundantNodes
+    analyzeZoneWithRedundant_test_data();
+}
+
+void Tests::sharedTree_test(){
+    QFETCH(QString, content);
+    QFETCH(COMPONENT_NAMES, selections);
+    QFETCH(int, suggestionCount);
+    QFETCH(bool, isTreeExpected);
+
+    // Вызов метода: одно общее дерево для всех запросов
+    CoverageResult failure;
+    const QSharedPointer<const SharedTree> tree = SharedTree::load(content, failure);
+    QCOMPARE(!tree.isNull(), isTreeExpected);
+    if (tree.isNull()) {
+        QCOMPARE(failure.isValid(), false);
+        QVERIFY(!failure.errors.isEmpty());
+        return;
+    }
+
+    // Запросы с разными отметками выполняются одновременно в пуле потоков
+    const QList<CoverageResult> results = QtConcurrent::blockingMapped<QList<CoverageResult>>(selections, [tree, suggestionCount](const QStringList& selection) {
+        CoverageQuery query(tree);
+        query.suggestionCount = suggestionCount;
+        QStringList invalidNames;
+        query.selectNodes(selection, invalidNames);
+        return query.analyze();
+    });
+
+    // Проверка результатов: каждый запрос совпадает с анализатором, разобравшим файл заново
+    for (int i = 0; i < selections.size(); ++i) {
+        TreeCoverageAnalyzer analyzer;
+        analyzer.suggestionCount = suggestionCount;
+        CoverageResult::Status status;
+        QVERIFY(analyzer.validate(content, status));
+        QStringList invalidNames;
+        QVERIFY(analyzer.selectNodes(selections[i], invalidNames));
+        const CoverageResult expected = analyzer.buildResult(analyzer.analyzeValidTree());
+
+        QCOMPARE(results[i].status, expected.status);
+        QCOMPARE(results[i].targetNodes, expected.targetNodes);
+        QCOMPARE(results[i].extraNodes, expected.extraNodes);
+        QCOMPARE(results[i].missingNodes, expected.missingNodes);
+        QCOMPARE(results[i].redundantNodes, expected.redundantNodes);
+        QCOMPARE(results[i].suggestedNodes, expected.suggestedNodes);
+    }
+}
+void Tests::sharedTree_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<COMPONENT_NAMES>("selections");
+    QTest::addColumn<int>("suggestionCount");
+    QTest::addColumn<bool>("isTreeExpected");
+
+    const QString tree = "digraph test {\nr;\nt[shape=square];\na;\nb;\nc;\nd;\ne;\nf;\n"
+                         "r->a;\nr->t;\nt->b;\nt->c;\nb->d;\nb->e;\nc->f;\n}";
+
+    // Тест 1: Разные отметки одного дерева, в том числе лишние, избыточные и недостающие узлы
+    {
+        COMPONENT_NAMES selections = {{}, {"b", "c"}, {"d", "e", "f"}, {"a", "b", "d"}, {"d"}, {"c", "f"}, {"b", "e", "c"}};
+        QTest::newRow("SeveralSelections") << tree << selections << 0 << true;
+    }
+
+    // Тест 2: Предложения отметок считаются в контексте запроса
+    {
+        COMPONENT_NAMES selections = {{}, {"d"}, {"f"}};
+        QTest::newRow("Suggestions") << tree << selections << 2 << true;
+    }
+
+    // Тест 3: Много одновременных запросов к большому дереву
+    {
+        QString content = "digraph test {\nroot[shape=square];\n";
+        for (int i = 0; i < 500; ++i) {
+            content += QString("root->n%1;\nn%1->m%1;\n").arg(i);
+        }
+        content += "}";
+        COMPONENT_NAMES selections;
+        for (int i = 0; i < 64; ++i) {
+            QStringList selection;
+            for (int j = i % 7; j < 500; j += 7) {
+                selection.append(QString(j % 2 == 0 ? "n%1" : "m%1").arg(j));
+            }
+            selections.append(selection);
+        }
+        QTest::newRow("ConcurrentQueries") << content << selections << 3 << true;
+    }
+
+    // Тест 4: Граф не является деревом, общее дерево не создается
+    {
+        QTest::newRow("NotTree") << QString("digraph test {\na[shape=square];\nb;\nc;\na->c;\nb->c;\n}") << COMPONENT_NAMES() << 0 << false;
+    }
+}
+
+void Tests::dotGenerator_test(){
+    QFETCH(DotGenerator::TreeShape, shape);
+    QFETCH(int, size);
+    QFETCH(int, cycleCount);
+    QFETCH(int, multiParentCount);
+    QFETCH(int, undirectedEdgeCount);
+    QFETCH(int, labelCount);
+    QFETCH(QStringList, expectedErrorTypes);
+
+    DotGenerator generator;
+    generator.shape = shape;
+    generator.size = size;
+    generator.arity = 3;
+    generator.seed = 42;
+    generator.selectedDensity = 0.2;
+    generator.cycleCount = cycleCount;
+    generator.multiParentCount = multiParentCount;
+    generator.undirectedEdgeCount = undirectedEdgeCount;
+    generator.nodeLabelCount = labelCount;
+    generator.edgeLabelCount = labelCount;
+
+    // Вызов метода: при одинаковом зерне вывод совпадает
+    const QString content = generator.generate();
+    QCOMPARE(generator.generate(), content);
+    if (shape == DotGenerator::RandomTree) {
+        generator.seed++;
+        QVERIFY(generator.generate() != content);
+    }
+
+    TreeCoverageAnalyzer analyzer;
+    CoverageResult::Status status;
+    const bool isValid = analyzer.validate(content, status);
+
+    // Проверка результатов: без внесенных ошибок получается дерево заданного размера, иначе найдены внесенные ошибки
+    if (expectedErrorTypes.isEmpty()) {
+        QVERIFY(isValid);
+        QCOMPARE(analyzer.treeMap.size(), size);
+        return;
+    }
+    QVERIFY(!isValid);
+    if (cycleCount > 0) {
+        // Внесенный цикл не дает родителя корню n0
+        for (Node* node : analyzer.treeMap) {
+            if (node->name == "n0") {
+                QCOMPARE(analyzer.amountOfParents.value(node), 0);
+            }
+        }
+    }
+    QStringList errorTypes;
+    for (const Error& error : analyzer.errors) {
+        errorTypes.append(error.typeName());
+    }
+    for (const QString& expectedType : expectedErrorTypes) {
+        QVERIFY2(errorTypes.contains(expectedType), qPrintable(expectedType));
+    }
+}
+void Tests::dotGenerator_test_data(){
+    QTest::addColumn<DotGenerator::TreeShape>("shape");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("cycleCount");
+    QTest::addColumn<int>("multiParentCount");
+    QTest::addColumn<int>("undirectedEdgeCount");
+    QTest::addColumn<int>("labelCount");
+    QTest::addColumn<QStringList>("expectedErrorTypes");
+
+    // Тест 1-4: Деревья каждой формы без ошибок
+    {
+        QTest::newRow("Chain") << DotGenerator::ChainTree << 300 << 0 << 0 << 0 << 0 << QStringList();
+        QTest::newRow("Star") << DotGenerator::StarTree << 300 << 0 << 0 << 0 << 0 << QStringList();
+        QTest::newRow("Balanced") << DotGenerator::BalancedTree << 300 << 0 << 0 << 0 << 0 << QStringList();
+        QTest::newRow("Random") << DotGenerator::RandomTree << 300 << 0 << 0 << 0 << 0 << QStringList();
+    }
+
+    // Тест 5: Дерево из одного целевого узла
+    {
+        QTest::newRow("SingleNode") << DotGenerator::RandomTree << 1 << 0 << 0 << 0 << 0 << QStringList();
+    }
+
+    // Тест 6: Внесенный цикл
+    {
+        QTest::newRow("Cycle") << DotGenerator::ChainTree << 100 << 1 << 0 << 0 << 0 << QStringList({"Cycle"});
+    }
+
+    // Тест 7: Циклы в звезде и в дереве, где у многих узлов родитель - корень, оставляют корень
+    {
+        QTest::newRow("StarCycle") << DotGenerator::StarTree << 100 << 3 << 0 << 0 << 0 << QStringList({"Cycle"});
+        QTest::newRow("BalancedCycle") << DotGenerator::BalancedTree << 100 << 5 << 0 << 0 << 0 << QStringList({"Cycle"});
+    }
+
+    // Тест 8: Узлы с несколькими родителями
+    {
+        QTest::newRow("MultiParents") << DotGenerator::BalancedTree << 100 << 0 << 3 << 0 << 0 << QStringList({"MultiParents"});
+    }
+
+    // Тест 9: Ненаправленное ребро
+    {
+        QTest::newRow("UndirectedEdge") << DotGenerator::RandomTree << 100 << 0 << 0 << 1 << 0 << QStringList({"UndirectedEdge"});
+    }
+
+    // Тест 10: Атрибуты label у узлов и ребер
+    {
+        QTest::newRow("Labels") << DotGenerator::StarTree << 100 << 0 << 0 << 0 << 2 << QStringList({"ExtraLabel", "EdgeLabel"});
+    }
+}
+
+void Tests::runStatistics_test(){
+    QFETCH(QString, content);
+    QFETCH(QStringList, expectedPhases);
+    QFETCH(int, expectedNodeCount);
+    QFETCH(int, expectedEdgeCount);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString statisticsFile = directory.filePath("stats.jsonl");
+
+    // Вызов метода: стадии проверки и анализа отмечает сам анализатор
+    RunStatistics statistics;
+    TreeCoverageAnalyzer analyzer;
+    analyzer.statistics = &statistics;
+    analyzer.resultFileName = directory.filePath("coverage_result.txt");
+    statistics.startPhase("parseDOT");
+    analyzer.parseDOT(content);
+    statistics.countTree(analyzer);
+    analyzer.fillHash(analyzer.treeMap, analyzer.amountOfParents);
+    analyzer.analyzeTreeCoverage();
+
+    // Две строки подряд дописываются в один файл
+    QVERIFY(statistics.write(statisticsFile));
+    QVERIFY(statistics.write(statisticsFile));
+    QFile file(statisticsFile);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    QCOMPARE(lines.size(), 3);
+    QVERIFY(lines[2].isEmpty());
+
+    // Проверка результатов
+    QJsonParseError parseError;
+    const QJsonObject object = QJsonDocument::fromJson(lines[0], &parseError).object();
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+    QStringList phases;
+    qint64 previousEnd = 0;
+    for (const QJsonValue& phase : object.value("phases").toArray()) {
+        phases.append(phase.toObject().value("name").toString());
+        QVERIFY(phase.toObject().value("start_ns").toDouble() >= previousEnd);
+        previousEnd = static_cast<qint64>(phase.toObject().value("start_ns").toDouble() + phase.toObject().value("duration_ns").toDouble());
+    }
+    QCOMPARE(phases, expectedPhases);
+    QVERIFY(object.value("total_ns").toDouble() >= previousEnd);
+    QCOMPARE(object.value("nodes").toInt(), expectedNodeCount);
+    QCOMPARE(object.value("edges").toInt(), expectedEdgeCount);
+    QVERIFY(object.contains("peak_rss_bytes"));
+    QVERIFY(object.contains("bytes_per_node"));
+
+    // Счетчики выделений памяти есть только в сборке с CONFIG+=allocation_profiler
+    QCOMPARE(object.contains("allocations"), AllocationProfiler::isEnabled());
+    QCOMPARE(object.value("allocation_source").toString(), AllocationProfiler::isEnabled() ? QString(AllocationProfiler::source()) : QString());
+    for (const QJsonValue& phase : object.value("phases").toArray()) {
+        QCOMPARE(phase.toObject().contains("allocations"), AllocationProfiler::isEnabled());
+        if (AllocationProfiler::isEnabled() && phase.toObject().value("name").toString() == "fillHash") {
+            QVERIFY(phase.toObject().value("allocations").toDouble() > 0);
+        }
+    }
+}
+void Tests::runStatistics_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QStringList>("expectedPhases");
+    QTest::addColumn<int>("expectedNodeCount");
+    QTest::addColumn<int>("expectedEdgeCount");
+
+    // Тест 1: Дерево без ошибок проходит все стадии
+    {
+        QTest::newRow("ValidTree") << QString("digraph test {\na[shape=square];\nb[shape=diamond];\nc;\na->b;\na->c;\n}")
+                                   << QStringList({"parseDOT", "fillHash", "validation", "analyzeTreeCoverage", "getResult"}) << 3 << 2;
+    }
+
+    // Тест 2: Граф с циклом не анализируется, но отчет об ошибках записывается
+    {
+        QTest::newRow("CycleSkipsCoverage") << QString("digraph test {\na[shape=square];\nb;\nc;\na->b;\nb->c;\nc->b;\n}")
+                                            << QStringList({"parseDOT", "fillHash", "validation", "getResult"}) << 3 << 3;
+    }
+}
+
+void Tests::traceRecorder_test(){
+    QFETCH(QStringList, contents);
+    QFETCH(int, threadCount);
+    QFETCH(bool, isDetailed);
+    QFETCH(QStringList, expectedNames);
+    QFETCH(QStringList, unexpectedNames);
+    QFETCH(int, expectedFileSpanCount);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    TraceRecorder trace;
+    trace.isDetailed = isDetailed;
+
+    // Вызов метода: один файл анализируется напрямую, несколько - пакетом на пуле потоков
+    if (threadCount == 0) {
+        TreeCoverageAnalyzer analyzer;
+        analyzer.trace = &trace;
+        analyzer.resultFileName = directory.filePath("coverage_result.txt");
+        analyzer.parseDOT(contents.first());
+        analyzer.fillHash(analyzer.treeMap, analyzer.amountOfParents);
+        analyzer.analyzeTreeCoverage();
+    }
+    else {
+        BatchAnalyzer batch;
+        batch.trace = &trace;
+        batch.threadCount = threadCount;
+        batch.outputDirectory = directory.filePath("results");
+        for (int i = 0; i < contents.size(); ++i) {
+            const QString inputFile = directory.filePath(QString("tree%1.dot").arg(i));
+            QFile file(inputFile);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+            file.write(contents[i].toUtf8());
+            file.close();
+            batch.inputFiles.append(inputFile);
+        }
+        QVERIFY(batch.run());
+    }
+    const QString traceFile = directory.filePath("trace.json");
+    QVERIFY(trace.write(traceFile));
+
+    // Проверка результатов: файл разбирается как JSON, отрезки имеют неотрицательное время и принадлежат известным потокам
+    QFile file(traceFile);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QJsonParseError parseError;
+    const QJsonArray events = QJsonDocument::fromJson(file.readAll(), &parseError).object().value("traceEvents").toArray();
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+    QSet<QString> names;
+    QSet<int> namedThreads;
+    int fileSpanCount = 0;
+    for (const QJsonValue& value : events) {
+        const QJsonObject event = value.toObject();
+        if (event.value("ph").toString() == "M") {
+            namedThreads.insert(event.value("tid").toInt());
+            continue;
+        }
+        QCOMPARE(event.value("ph").toString(), QString("X"));
+        QVERIFY(event.value("ts").toDouble() >= 0.0);
+        QVERIFY(event.value("dur").toDouble() >= 0.0);
+        QVERIFY(namedThreads.contains(event.value("tid").toInt()));
+        names.insert(event.value("name").toString());
+        if (event.value("name").toString() == "file") {
+            fileSpanCount++;
+        }
+    }
+    for (const QString& name : expectedNames) {
+        QVERIFY2(names.contains(name), qPrintable(name));
+    }
+    for (const QString& name : unexpectedNames) {
+        QVERIFY2(!names.contains(name), qPrintable(name));
+    }
+    QCOMPARE(fileSpanCount, expectedFileSpanCount);
+}
+void Tests::traceRecorder_test_data(){
+    QTest::addColumn<QStringList>("contents");
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("isDetailed");
+    QTest::addColumn<QStringList>("expectedNames");
+    QTest::addColumn<QStringList>("unexpectedNames");
+    QTest::addColumn<int>("expectedFileSpanCount");
+
+    const QString tree = "digraph test {\nr;\nt[shape=square];\ns[shape=diamond];\na;\nb;\nr->s;\nr->t;\ns->a;\nt->b;\n}";
+
+    // Тест 1: Проходы разбора, проверка корня и один отрезок обхода зон одного дерева
+    {
+        QTest::newRow("SingleTree") << QStringList({tree}) << 0 << false
+                                    << QStringList({"node regex pass", "symbol table build", "edge regex pass", "undirected edge regex pass",
+                                                    "fillHash", "hasCycles", "connectivity check", "analyzeZoneWithExtraNodes", "writeResultFile"})
+                                    << QStringList({"analyzeZoneWithMissingNodes", "analyzeZoneWithRedundantNodes"}) << 0;
+    }
+
+    // Тест 2: Подробная трассировка записывает каждую зону недостающих и избыточных узлов
+    {
+        QTest::newRow("DetailedZones") << QStringList({tree}) << 0 << true
+                                       << QStringList({"analyzeZoneWithExtraNodes", "analyzeZoneWithMissingNodes", "analyzeZoneWithRedundantNodes"})
+                                       << QStringList() << 0;
+    }
+
+    // Тест 3: Пакет файлов, у каждого файла свой отрезок на потоке пула
+    {
+        QTest::newRow("Batch") << QStringList({tree, tree, tree, tree}) << 2 << false
+                               << QStringList({"file", "read", "node regex pass", "hasCycles", "writeResultFile"}) << QStringList() << 4;
+    }
+}
+
+void Tests::visitCounters_test(){
+    QFETCH(QString, content);
+    QFETCH(TreeCoverageAnalyzer::TraversalFunction, function);
+    QFETCH(qint64, expectedVisits);
+    QFETCH(bool, isWarningExpected);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    // Вызов метода: посещения передаются в статистику после проверки графа и после анализа
+    RunStatistics statistics;
+    statistics.visitWarningFactor = 2;
+    TreeCoverageAnalyzer analyzer;
+    analyzer.statistics = &statistics;
+    analyzer.resultFileName = directory.filePath("coverage_result.txt");
+    analyzer.parseDOT(content);
+    statistics.countTree(analyzer);
+    analyzer.fillHash(analyzer.treeMap, analyzer.amountOfParents);
+    if (analyzer.errors.isEmpty()) {
+        analyzer.analyzeTreeCoverage();
+    }
+
+    // Проверка результатов
+    QCOMPARE(statistics.visitCounts.size(), int(TreeCoverageAnalyzer::TraversalFunctionCount));
+    QCOMPARE(statistics.visitCounts[function], expectedVisits);
+    QCOMPARE(!statistics.visitWarnings().isEmpty(), isWarningExpected);
+}
+void Tests::visitCounters_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<TreeCoverageAnalyzer::TraversalFunction>("function");
+    QTest::addColumn<qint64>("expectedVisits");
+    QTest::addColumn<bool>("isWarningExpected");
+
+    const QString tree = "digraph test {\na[shape=square];\nb;\nc;\na->b;\na->c;\n}";
+
+    // Тест 1: В дереве поиск циклов посещает каждый узел один раз
+    {
+        QTest::newRow("TreeCycleSearch") << tree << TreeCoverageAnalyzer::HasCyclesTraversal << qint64(3) << false;
+    }
+
+    // Тест 2: Зона недостающих узлов начинается с целевого корня и посещает все узлы
+    {
+        QTest::newRow("TreeMissingZone") << tree << TreeCoverageAnalyzer::MissingZoneTraversal << qint64(3) << false;
+    }
+
+    // Тест 3: В графе с узлами, у которых несколько родителей, поиск циклов проходит каждый путь до узла
+    {
+        QTest::newRow("DiamondChainRevisitsNodes") << QString("digraph test {\nr[shape=square];\na1;\na2;\nb;\nc1;\nc2;\nd;\ne;\n"
+                                                              "r->a1;\nr->a2;\na1->b;\na2->b;\nb->c1;\nb->c2;\nc1->d;\nc2->d;\nd->e;\n}")
+                                                   << TreeCoverageAnalyzer::HasCyclesTraversal << qint64(17) << true;
+    }
+}
+
+void Tests::differentialFuzzer_test(){
+    QFETCH(quint32, seed);
+    QFETCH(int, iterations);
+    QFETCH(bool, isBugInjected);
+
+    // Вариант с внесенной ошибкой теряет недостающие узлы
+    DifferentialFuzzer fuzzer;
+    if (isBugInjected) {
+        fuzzer.engines.append(qMakePair(QString("DropsMissingNodes"), DifferentialFuzzer::Engine([](const QString& content) {
+            CoverageResult result = DifferentialFuzzer::reference(content);
+            result.missingNodes.clear();
+            return result;
+        })));
+    }
+
+    // Вызов метода
+    QString report;
+    QTextStream reportStream(&report);
+    const int failedCount = fuzzer.run(seed, iterations, reportStream);
+
+    // Проверка результатов: без внесенной ошибки все варианты совпадают с эталоном
+    if (!isBugInjected) {
+        QVERIFY2(failedCount == 0, qPrintable(report));
+        return;
+    }
+    QVERIFY(failedCount > 0);
+    QVERIFY(report.contains("DropsMissingNodes.missingNodes"));
+
+    // Уменьшенный контрпример сохраняет расхождение, а удаление любой его строки расхождение убирает
+    QRandomGenerator random(seed);
+    QString content;
+    while (fuzzer.compare(content).isEmpty()) {
+        content = DifferentialFuzzer::generateInput(random);
+    }
+    const QStringList minimizedLines = fuzzer.minimize(content, "DropsMissingNodes").split('\n');
+    QVERIFY(minimizedLines.size() <= content.split('\n').size());
+    QVERIFY(!fuzzer.compare(minimizedLines.join('\n')).isEmpty());
+    for (int i = 0; i < minimizedLines.size(); ++i) {
+        QStringList shorter = minimizedLines;
+        shorter.removeAt(i);
+        QVERIFY(fuzzer.compare(shorter.join('\n')).isEmpty());
+    }
+}
+void Tests::differentialFuzzer_test_data(){
+    QTest::addColumn<quint32>("seed");
+    QTest::addColumn<int>("iterations");
+    QTest::addColumn<bool>("isBugInjected");
+
+    // Тест 1: Варианты анализа совпадают с эталоном на деревьях и графах с ошибками
+    {
+        QTest::newRow("EnginesMatchReference") << quint32(1) << 500 << false;
+    }
+
+    // Тест 2: Внесенная ошибка находится и уменьшается до минимального контрпримера
+    {
+        QTest::newRow("InjectedBugIsMinimized") << quint32(2) << 200 << true;
+    }
+}
+
+void Tests::graphProfile_test(){
+    QFETCH(QString, content);
+    QFETCH(QList<int>, expectedCounts);
+    QFETCH(QVector<qint64>, expectedDepthHistogram);
+    QFETCH(QVector<qint64>, expectedFanOutHistogram);
+    QFETCH(QStringList, expectedLargestSubtrees);
+
+    // Вызов метода: профиль строится сразу после разбора
+    TreeCoverageAnalyzer analyzer;
+    analyzer.parseDOT(content);
+    const GraphProfile profile(analyzer.treeMap);
+
+    // Проверка результатов
+    const QList<int> counts = {profile.nodeCount, profile.edgeCount, profile.rootCount, profile.leafCount,
+                               profile.targetCount, profile.selectedCount, profile.maxDepth, profile.maxFanOut};
+    QCOMPARE(counts, expectedCounts);
+    QCOMPARE(profile.depthHistogram, expectedDepthHistogram);
+    QCOMPARE(profile.fanOutHistogram, expectedFanOutHistogram);
+    QStringList largestSubtrees;
+    for (const QPair<QString, int>& subtree : profile.largestSubtrees) {
+        largestSubtrees.append(QString("%1:%2").arg(subtree.first).arg(subtree.second));
+    }
+    QCOMPARE(largestSubtrees, expectedLargestSubtrees);
+
+    // JSON-вывод содержит те же значения
+    QString text;
+    QTextStream out(&text);
+    JsonStreamWriter json(out);
+    profile.writeJson(json);
+    out.flush();
+    const QJsonObject object = QJsonDocument::fromJson(text.toUtf8()).object();
+    QCOMPARE(object.value("nodes").toInt(), expectedCounts[0]);
+    QCOMPARE(object.value("max_depth").toInt(), expectedCounts[6]);
+    QCOMPARE(object.value("largest_subtrees").toArray().size(), expectedLargestSubtrees.size());
+}
+void Tests::graphProfile_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QList<int>>("expectedCounts");
+    QTest::addColumn<QVector<qint64>>("expectedDepthHistogram");
+    QTest::addColumn<QVector<qint64>>("expectedFanOutHistogram");
+    QTest::addColumn<QStringList>("expectedLargestSubtrees");
+
+    // Тест 1: Дерево: глубины 0, 1, 1, 2, 2, 2 и количества детей 2, 3, 0, 0, 0, 0 по интервалам 0, 1, 2-3
+    {
+        QTest::newRow("Tree") << QString("digraph test {\na[shape=square];\nf[shape=diamond];\na->b;\na->c;\nb->d;\nb->e;\nb->f;\n}")
+                              << QList<int>({6, 5, 1, 4, 1, 1, 2, 3})
+                              << QVector<qint64>({1, 2, 3}) << QVector<qint64>({4, 0, 2})
+                              << QStringList({"b:4", "c:1", "d:1", "e:1", "f:1"});
+    }
+
+    // Тест 2: Цикл без корня обходится от первого узла, профиль строится без проверки графа
+    {
+        QTest::newRow("CycleWithoutRoot") << QString("digraph test {\na[shape=square];\na->b;\nb->c;\nc->a;\n}")
+                                          << QList<int>({3, 3, 0, 0, 1, 0, 2, 1})
+                                          << QVector<qint64>({1, 1, 1}) << QVector<qint64>({0, 3})
+                                          << QStringList({"b:2", "c:1"});
+    }
+}
+
+void Tests::resourceLimits_test(){
+    QFETCH(QString, content);
+    QFETCH(QList<qint64>, limitValues);
+    QFETCH(CoverageResult::Status, expectedStatus);
+    QFETCH(QList<Error>, expectedErrors);
+
+    // Ограничения: узлы, ребра, глубина, размер входа, оценка памяти
+    ResourceLimits limits;
+    limits.maxNodes = limitValues[0];
+    limits.maxEdges = limitValues[1];
+    limits.maxDepth = limitValues[2];
+    limits.maxInputBytes = limitValues[3];
+    limits.maxMemoryBytes = limitValues[4];
+
+    // Вызов метода
+    TreeCoverageAnalyzer analyzer;
+    analyzer.limits = &limits;
+    const CoverageResult result = analyzer.analyze(content);
+
+    // Проверка результатов: превышение останавливает анализ с отдельной ошибкой
+    QCOMPARE(result.status, expectedStatus);
+    QCOMPARE(result.errors, expectedErrors);
+    QCOMPARE(analyzer.isLimitExceeded, expectedStatus == CoverageResult::LimitExceeded);
+}
+void Tests::resourceLimits_test_data(){
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QList<qint64>>("limitValues");
+    QTest::addColumn<CoverageResult::Status>("expectedStatus");
+    QTest::addColumn<QList<Error>>("expectedErrors");
+
+    const QString chain = "digraph test {\na[shape=square];\nd[shape=diamond];\ne[shape=diamond];\na->b;\nb->c;\nc->d;\nc->e;\n}";
+
+    // Тест 1: Ограничения не превышены, дерево покрыто
+    {
+        QTest::newRow("WithinLimits") << chain << QList<qint64>({5, 4, 3, 1000, 4096})
+                                      << CoverageResult::Covered << QList<Error>();
+    }
+
+    // Тест 2: Узлов больше, чем разрешено
+    {
+        QTest::newRow("TooManyNodes") << chain << QList<qint64>({4, 0, 0, 0, 0})
+                                      << CoverageResult::LimitExceeded << QList<Error>({Error(Error::LimitExceeded)});
+    }
+
+    // Тест 3: Ребер больше, чем разрешено
+    {
+        QTest::newRow("TooManyEdges") << chain << QList<qint64>({0, 3, 0, 0, 0})
+                                      << CoverageResult::LimitExceeded << QList<Error>({Error(Error::LimitExceeded)});
+    }
+
+    // Тест 4: Глубина цепочки больше разрешенной, обход останавливается без переполнения стека
+    {
+        QTest::newRow("TooDeep") << chain << QList<qint64>({0, 0, 2, 0, 0})
+                                 << CoverageResult::LimitExceeded << QList<Error>({Error(Error::LimitExceeded)});
+    }
+
+    // Тест 5: Входные данные больше разрешенного размера, разбор не начинается
+    {
+        QTest::newRow("InputTooLarge") << chain << QList<qint64>({0, 0, 0, 16, 0})
+                                       << CoverageResult::LimitExceeded << QList<Error>({Error(Error::LimitExceeded)});
+    }
+
+    // Тест 6: Размер считается в байтах UTF-8, а не в символах: 59 символов, но 65 байт
+    {
+        QTest::newRow("InputBytesNotCharacters") << QString("digraph дерево {\na[shape=square];\nb[shape=diamond];\na->b;\n}")
+                                                 << QList<qint64>({0, 0, 0, 62, 0})
+                                                 << CoverageResult::LimitExceeded << QList<Error>({Error(Error::LimitExceeded)});
+    }
+
+    // Тест 7: Оценка памяти анализатора (текст, 5 узлов по 256 байт и 4 ребра по 32 байта) больше разрешенной
+    {
+        QTest::newRow("MemoryEstimateExceeded") << chain << QList<qint64>({0, 0, 0, 0, 1000})
+                                                << CoverageResult::LimitExceeded << QList<Error>({Error(Error::LimitExceeded)});
+    }
+}
+
+void Tests::batchResourceLimits_test(){
+    QFETCH(QList<int>, leafCounts);
+    QFETCH(int, maxMemoryMb);
+    QFETCH(QStringList, expectedStatuses);
+
+    // Подготовка входных файлов: звезды с целевым корнем и заданным количеством листьев
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QStringList inputFiles;
+    for (int i = 0; i < leafCounts.size(); ++i) {
+        QString content = "digraph test {\na[shape=square];\n";
+        for (int leaf = 0; leaf < leafCounts[i]; ++leaf) {
+            content += QString("a->n%1;\n").arg(leaf);
+        }
+        content += "}";
+        inputFiles.append(directory.filePath(QString("tree%1.dot").arg(i)));
+        QFile file(inputFiles.last());
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+        file.write(content.toUtf8());
+        file.close();
+    }
+
+    // Вызов метода: файлы пакета анализируются по очереди с общими ограничениями
+    ResourceLimits limits;
+    limits.maxMemoryBytes = qint64(maxMemoryMb) * 1024 * 1024;
+    BatchAnalyzer batch;
+    batch.limits = &limits;
+    QStringList statuses;
+    for (int i = 0; i < inputFiles.size(); ++i) {
+        const BatchAnalyzer::Item item = batch.analyzeFile(inputFiles[i], directory.filePath(QString("tree%1.txt").arg(i)));
+        statuses.append(BatchAnalyzer::statusName(item));
+    }
+
+    // Проверка результатов: память оценивается по данным каждого файла, большой файл не засчитывается следующим
+    QCOMPARE(statuses, expectedStatuses);
+}
+void Tests::batchResourceLimits_test_data(){
+    QTest::addColumn<QList<int>>("leafCounts");
+    QTest::addColumn<int>("maxMemoryMb");
+    QTest::addColumn<QStringList>("expectedStatuses");
+
+    // Тест 1: Оценка памяти большого файла превышает ограничение, следующий за ним небольшой файл анализируется
+    {
+        QTest::newRow("LargeThenSmall") << QList<int>({400000, 3000}) << 16
+                                        << (QStringList{"LimitExceeded", "NotCovered"});
+    }
+}
@@ -11,6 +11,17 @@
 #include "node.h"
 #include "error.h"
 #include "treecoverageanalyzer.h"
+#include "coverageexporter.h"
+#include "batchanalyzer.h"
+#include "coveragedaemon.h"
+#include "coveragewatcher.h"
+#include "coverageengine.h"
+#include "sharedtree.h"
+#include "dotgenerator.h"
+#include "runstatistics.h"
+#include "tracerecorder.h"
+#include "differentialfuzzer.h"
+#include "graphprofile.h"
 
 /*!
  * \brief Класс для тестирования функций
@@ -80,6 +91,20 @@ private:
     */
     bool compareNodes(QPair<const Node*, const Node*> pair, QSet<QPair<const Node*, const Node*>>& visited);
 
+    /*!
+    * \brief Функция разбирает, проверяет и анализирует дерево внутри теста, не записывая результат в файл
+    * \param[in] content - содержимое DOT-файла
+    * \param[in,out] analyzer - анализатор, в котором будет сохранен результат
+    */
+    void prepareAnalyzer(const QString& content, TreeCoverageAnalyzer& analyzer);
+
+    /*!
+    * \brief Функция переводит контейнер узлов в отсортированный список имен
+    * \param[in] nodes - контейнер узлов
+    * \return отсортированный список имен узлов
+    */
+    QStringList sortedNames(const QSet<Node*>& nodes);
+
 private slots:
     void parseDOT_test();
     void parseDOT_test_data();
@@ -98,6 +123,87 @@ private slots:
 
     void analyzeZoneWithRedundant_test();
     void analyzeZoneWithRedundant_test_data();
+
+    void splitIntoComponents_test();
+    void splitIntoComponents_test_data();
+
+    void analyzeForest_test();
+    void analyzeForest_test_data();
+
+    void diffWith_test();
+    void diffWith_test_data();
+
+    void suggestMarks_test();
+    void suggestMarks_test_data();
+
+    void coverageExporter_test();
+    void coverageExporter_test_data();
+
+    void writeResult_test();
+    void writeResult_test_data();
+
+    void writeJsonResult_test();
+    void writeJsonResult_test_data();
+
+    void analyze_test();
+    void analyze_test_data();
+
+    void batchAnalyzer_test();
+    void batchAnalyzer_test_data();
+
+    void coverageDaemon_test();
+    void coverageDaemon_test_data();
+
+    void coverageWatcher_test();
+    void coverageWatcher_test_data();
+
+    void analyzeAsync_test();
+    void analyzeAsync_test_data();
+
+    void analyzeAsyncCancel_test();
+    void analyzeAsyncCancel_test_data();
+
+    void parseProgress_test();
+    void parseProgress_test_data();
+
+    void resultCache_test();
+    void resultCache_test_data();
+
+    void coverageEngineExtraZone_test();
+    void coverageEngineExtraZone_test_data();
+
+    void coverageEngineMissingZone_test();
+    void coverageEngineMissingZone_test_data();
+
+    void coverageEngineRedundantZone_test();
+    void coverageEngineRedundantZone_test_data();
+
+    void sharedTree_test();
+    void sharedTree_test_data();
+
+    void dotGenerator_test();
+    void dotGenerator_test_data();
+
+    void runStatistics_test();
+    void runStatistics_test_data();
+
+    void traceRecorder_test();
+    void traceRecorder_test_data();
+
+    void visitCounters_test();
+    void visitCounters_test_data();
+
+    void differentialFuzzer_test();
+    void differentialFuzzer_test_data();
+
+    void graphProfile_test();
+    void graphProfile_test_data();
+
+    void resourceLimits_test();
+    void resourceLimits_test_data();
+
+    void batchResourceLimits_test();
+    void batchResourceLimits_test_data();
 };
 
 #endif // TESTS_H
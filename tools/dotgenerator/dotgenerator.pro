@@ -0,0 +1,13 @@
+QT += core
+CONFIG += c++17 console
+
+TARGET = DotGenerator
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    main.cpp \
+    $$PWD/../../dotgenerator.cpp
+
+HEADERS += \
+    $$PWD/../../dotgenerator.h
@@ -0,0 +1,119 @@
+/*!
+* \file
+* \brief Данный файл содержит главную функцию программы DotGenerator, создающей DOT-деревья для нагрузочных тестов.
+*
+* Пример команды запуска программы:
+* \code
+DotGenerator.exe --shape balanced --arity 4 --size 1000000 --selected 0.1 --seed 7 tree.dot
+* \endcode
+*
+* Без имени выходного файла дерево записывается в стандартный вывод.
+*/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include "dotgenerator.h"
+
+/*!
+ * \brief Читает целое неотрицательное значение параметра
+ * \param [in] parser - разобранные параметры
+ * \param [in] name - имя параметра
+ * \param [out] value - значение
+ * \return true - если значение корректно, false - в противном случае
+ */
+bool readCount(const QCommandLineParser& parser, const QString& name, int& value) {
+    bool isNumber = false;
+    value = parser.value(name).toInt(&isNumber);
+    if (!isNumber || value < 0) {
+        QTextStream(stderr) << "Ошибка: параметр --" << name << " должен быть неотрицательным целым числом\n";
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Читает вероятность из отрезка [0, 1]
+ * \param [in] parser - разобранные параметры
+ * \param [in] name - имя параметра
+ * \param [out] value - значение
+ * \return true - если значение корректно, false - в противном случае
+ */
+bool readDensity(const QCommandLineParser& parser, const QString& name, double& value) {
+    bool isNumber = false;
+    value = parser.value(name).toDouble(&isNumber);
+    if (!isNumber || value < 0.0 || value > 1.0) {
+        QTextStream(stderr) << "Ошибка: параметр --" << name << " должен быть числом от 0 до 1\n";
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Главная функция программы DotGenerator
+ * \param [in] argc - количество переданных аргументов командной строки
+ * \param [in] argv - переданные аргументы командной строки
+ * \return 0 - дерево записано; 1 - ошибка в параметрах или при записи файла
+ */
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Генератор DOT-деревьев заданного размера и формы");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("shape", "Форма дерева: chain, star, balanced или random", "shape", "random"));
+    parser.addOption(QCommandLineOption("size", "Количество узлов", "n", "1000"));
+    parser.addOption(QCommandLineOption("arity", "Количество детей у узлов сбалансированного дерева", "k", "2"));
+    parser.addOption(QCommandLineOption("seed", "Зерно генератора случайных чисел", "seed", "1"));
+    parser.addOption(QCommandLineOption("targets", "Вероятность, что узел целевой (n1 целевой всегда)", "p", "0"));
+    parser.addOption(QCommandLineOption("selected", "Вероятность, что нецелевой узел отмечен", "p", "0"));
+    parser.addOption(QCommandLineOption("cycles", "Количество внесенных циклов", "n", "0"));
+    parser.addOption(QCommandLineOption("multi-parents", "Количество узлов со вторым родителем", "n", "0"));
+    parser.addOption(QCommandLineOption("undirected", "Количество ненаправленных ребер", "n", "0"));
+    parser.addOption(QCommandLineOption("node-labels", "Количество узлов с атрибутом label", "n", "0"));
+    parser.addOption(QCommandLineOption("edge-labels", "Количество ребер с атрибутом label", "n", "0"));
+    parser.addPositionalArgument("output", "Выходной DOT-файл (по умолчанию стандартный вывод)");
+    parser.process(app);
+
+    // 1. Проверка параметров
+    DotGenerator generator;
+    if (!DotGenerator::parseShape(parser.value("shape"), generator.shape)) {
+        QTextStream(stderr) << "Ошибка: неизвестная форма дерева " << parser.value("shape") << "\n";
+        return 1;
+    }
+    bool isSeedNumber = false;
+    generator.seed = parser.value("seed").toUInt(&isSeedNumber);
+    if (!isSeedNumber) {
+        QTextStream(stderr) << "Ошибка: параметр --seed должен быть неотрицательным целым числом\n";
+        return 1;
+    }
+    if (!readCount(parser, "size", generator.size) || !readCount(parser, "arity", generator.arity)
+        || !readCount(parser, "cycles", generator.cycleCount) || !readCount(parser, "multi-parents", generator.multiParentCount)
+        || !readCount(parser, "undirected", generator.undirectedEdgeCount) || !readCount(parser, "node-labels", generator.nodeLabelCount)
+        || !readCount(parser, "edge-labels", generator.edgeLabelCount)
+        || !readDensity(parser, "targets", generator.targetDensity) || !readDensity(parser, "selected", generator.selectedDensity)) {
+        return 1;
+    }
+
+    // 2. Запись дерева потоком, чтобы большие деревья не собирались в памяти
+    const QStringList positional = parser.positionalArguments();
+    QFile file;
+    bool isOpened = false;
+    if (positional.isEmpty()) {
+        isOpened = file.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+    else {
+        file.setFileName(positional.first());
+        isOpened = file.open(QIODevice::WriteOnly | QIODevice::Text);
+    }
+    if (!isOpened) {
+        QTextStream(stderr) << "Ошибка: не удалось открыть файл " << file.fileName() << " для записи\n";
+        return 1;
+    }
+    QTextStream out(&file);
+    generator.write(out);
+    out.flush();
+    file.close();
+    return 0;
+}
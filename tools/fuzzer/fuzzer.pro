@@ -0,0 +1,16 @@
+QT += core
+CONFIG += c++17 console
+
+TARGET = DifferentialFuzzer
+
+include(../../treecoverage.pri)  # исходные файлы анализатора
+
+# Сборка под libFuzzer вместо цикла с зерном (нужен clang): qmake "CONFIG+=libfuzzer"
+libfuzzer {
+    DEFINES += TREECOVERAGE_LIBFUZZER
+    QMAKE_CXXFLAGS += -fsanitize=fuzzer,address
+    QMAKE_LFLAGS += -fsanitize=fuzzer,address
+}
+
+SOURCES += \
+    main.cpp
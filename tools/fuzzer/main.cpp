@@ -0,0 +1,107 @@
+/*!
+* \file
+* \brief Данный файл содержит главную функцию программы DifferentialFuzzer, сравнивающей варианты анализа покрытия с эталоном.
+*
+* Пример команды запуска программы:
+* \code
+DifferentialFuzzer.exe --seed 7 --iterations 100000
+* \endcode
+*
+* Контрпример из отчета проверяется повторно параметром --input. В сборке с CONFIG+=libfuzzer вместо функции main
+* собирается LLVMFuzzerTestOneInput, и входы подбирает libFuzzer:
+* \code
+DifferentialFuzzer corpus -max_len=4096
+* \endcode
+*/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <cstdlib>
+#include "differentialfuzzer.h"
+
+#ifdef TREECOVERAGE_LIBFUZZER
+
+/*!
+ * \brief Точка входа libFuzzer: при расхождении записывает уменьшенный контрпример и прерывает программу
+ * \param [in] data - вход
+ * \param [in] size - размер входа в байтах
+ * \return 0
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static const DifferentialFuzzer fuzzer;
+    const QString content = QString::fromUtf8(reinterpret_cast<const char*>(data), static_cast<qsizetype>(size));
+    const QList<DifferentialFuzzer::Mismatch> mismatches = fuzzer.compare(content);
+    if (!mismatches.isEmpty()) {
+        // Прерывание сохраняет исходный вход в файл crash-*, в отчет пишется уменьшенный
+        const QString engine = mismatches.first().engine;
+        const QString minimized = fuzzer.minimize(content, engine);
+        QList<DifferentialFuzzer::Mismatch> minimizedMismatches;
+        for (const DifferentialFuzzer::Mismatch& mismatch : fuzzer.compare(minimized)) {
+            if (mismatch.engine == engine) {
+                minimizedMismatches.append(mismatch);
+            }
+        }
+        QTextStream report(stderr);
+        DifferentialFuzzer::writeMismatches(minimized, minimizedMismatches, report);
+        report.flush();
+        std::abort();
+    }
+    return 0;
+}
+
+#else
+
+/*!
+ * \brief Главная функция программы DifferentialFuzzer
+ * \param [in] argc - количество переданных аргументов командной строки
+ * \param [in] argv - переданные аргументы командной строки
+ * \return 0 - расхождений нет; 1 - найдены расхождения или ошибка в параметрах
+ */
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Дифференциальный фаззинг: варианты анализа покрытия сравниваются с TreeCoverageAnalyzer на случайных DOT-входах.");
+    parser.addHelpOption();
+    QCommandLineOption seedOption("seed", "Зерно генератора входов.", "seed", "1");
+    parser.addOption(seedOption);
+    QCommandLineOption iterationsOption("iterations", "Количество входов.", "n", "10000");
+    parser.addOption(iterationsOption);
+    QCommandLineOption inputOption("input", "Проверить один DOT-файл вместо случайных входов.", "file.dot");
+    parser.addOption(inputOption);
+    parser.process(app);
+
+    QTextStream report(stderr);
+    const DifferentialFuzzer fuzzer;
+
+    // Повторная проверка контрпримера
+    if (parser.isSet(inputOption)) {
+        QFile file(parser.value(inputOption));
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            report << "Ошибка: не удалось открыть файл " << parser.value(inputOption) << "\n";
+            return 1;
+        }
+        const QString content = QString::fromUtf8(file.readAll());
+        const QList<DifferentialFuzzer::Mismatch> mismatches = fuzzer.compare(content);
+        if (!mismatches.isEmpty()) {
+            DifferentialFuzzer::writeMismatches(content, mismatches, report);
+        }
+        return mismatches.isEmpty() ? 0 : 1;
+    }
+
+    bool isSeedNumber = false;
+    bool isIterationsNumber = false;
+    const quint32 seed = parser.value(seedOption).toUInt(&isSeedNumber);
+    const int iterations = parser.value(iterationsOption).toInt(&isIterationsNumber);
+    if (!isSeedNumber || !isIterationsNumber || iterations < 0) {
+        report << "Ошибка: параметры --seed и --iterations должны быть неотрицательными целыми числами\n";
+        return 1;
+    }
+    const int failedCount = fuzzer.run(seed, iterations, report);
+    report << "Проверено входов: " << iterations << ", с расхождениями: " << failedCount << "\n";
+    return failedCount == 0 ? 0 : 1;
+}
+
+#endif // TREECOVERAGE_LIBFUZZER
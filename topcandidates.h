@@ -0,0 +1,64 @@
+/*!
+* \file
+* \brief Файл содержит шаблон класса TopCandidates – выбора k лучших кандидатов без сортировки всех кандидатов.
+*/
+
+#ifndef TOPCANDIDATES_H
+#define TOPCANDIDATES_H
+
+#include <QList>
+#include <queue>
+#include <vector>
+
+/*!
+* \brief Выбор k лучших кандидатов за O(n log k).
+*
+* Куча из не более чем k кандидатов хранит на вершине худшего из них, поэтому новый кандидат сравнивается
+* только с вершиной. Используется для предложений отметок в TreeCoverageAnalyzer::suggestMarks и CoverageQuery::analyze.
+*/
+template <typename T, typename Compare>
+class TopCandidates
+{
+public:
+    /*!
+    * \brief Конструктор выбора
+    * \param [in] k - количество выбираемых кандидатов
+    * \param [in] isBetter - сравнение, возвращающее true, если первый кандидат лучше второго
+    */
+    TopCandidates(int k, Compare isBetter)
+        : k(k), isBetter(isBetter), heap(isBetter) {}
+
+    /*!
+    * \brief Предлагает кандидата, который остается, если лучше худшего из выбранных
+    * \param [in] candidate - кандидат
+    */
+    void offer(const T& candidate) {
+        if (static_cast<int>(heap.size()) < k) {
+            heap.push(candidate);
+        }
+        else if (k > 0 && isBetter(candidate, heap.top())) {
+            heap.pop();
+            heap.push(candidate);
+        }
+    }
+
+    /*!
+    * \brief Извлекает выбранных кандидатов
+    * \return список кандидатов от лучшего к худшему
+    */
+    QList<T> take() {
+        QList<T> result(static_cast<int>(heap.size()));
+        for (int i = result.size() - 1; i >= 0; --i) {
+            result[i] = heap.top();
+            heap.pop();
+        }
+        return result;
+    }
+
+private:
+    int k; //!< количество выбираемых кандидатов
+    Compare isBetter; //!< сравнение кандидатов
+    std::priority_queue<T, std::vector<T>, Compare> heap; //!< выбранные кандидаты, худший на вершине
+};
+
+#endif // TOPCANDIDATES_H
@@ -0,0 +1,114 @@
+/*!
+* \file
+* \brief Файл содержит реализацию функций класса TraceRecorder.
+*/
+
+#include "tracerecorder.h"
+#include <QFile>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <QThread>
+#include "jsonstreamwriter.h"
+
+TraceRecorder::Span::Span(TraceRecorder* recorder, const char* name, const char* category, const QString& detail)
+    : recorder(recorder), name(name), category(category), detail(detail), startNs(recorder ? recorder->timer.nsecsElapsed() : 0) {}
+
+TraceRecorder::Span::~Span() {
+    finish();
+}
+
+void TraceRecorder::Span::finish() {
+    if (recorder) {
+        recorder->addEvent(QString::fromUtf8(name), QString::fromUtf8(category), detail, startNs, recorder->timer.nsecsElapsed() - startNs);
+        recorder = nullptr;
+    }
+}
+
+TraceRecorder::TraceRecorder()
+    : isDetailed(false) {
+    timer.start();
+}
+
+void TraceRecorder::addEvent(const QString& name, const QString& category, const QString& detail, qint64 startNs, qint64 durationNs) {
+    QMutexLocker locker(&mutex);
+    const Qt::HANDLE threadId = QThread::currentThreadId();
+    auto found = threadIndices.constFind(threadId);
+    if (found == threadIndices.constEnd()) {
+        found = threadIndices.insert(threadId, threadIndices.size());
+    }
+
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.detail = detail;
+    event.startNs = startNs;
+    event.durationNs = durationNs;
+    event.thread = found.value();
+    events.append(event);
+}
+
+bool TraceRecorder::write(const QString& fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QMutexLocker locker(&mutex);
+    QTextStream out(&file);
+    JsonStreamWriter json(out);
+    json.beginObject();
+    json.key("traceEvents");
+    json.beginArray();
+
+    // 1. Имена потоков: первый поток с событиями обычно главный, остальные - потоки пула
+    for (int thread = 0; thread < threadIndices.size(); ++thread) {
+        json.beginObject();
+        json.key("ph");
+        json.value("M");
+        json.key("name");
+        json.value("thread_name");
+        json.key("pid");
+        json.value(1);
+        json.key("tid");
+        json.value(thread);
+        json.key("args");
+        json.beginObject();
+        json.key("name");
+        json.value(QString("thread %1").arg(thread));
+        json.endObject();
+        json.endObject();
+    }
+
+    // 2. Отрезки, время в формате trace-event задается в микросекундах
+    for (const Event& event : events) {
+        json.beginObject();
+        json.key("name");
+        json.value(event.name);
+        json.key("cat");
+        json.value(event.category);
+        json.key("ph");
+        json.value("X");
+        json.key("ts");
+        json.value(event.startNs / 1000.0);
+        json.key("dur");
+        json.value(event.durationNs / 1000.0);
+        json.key("pid");
+        json.value(1);
+        json.key("tid");
+        json.value(event.thread);
+        if (!event.detail.isEmpty()) {
+            json.key("args");
+            json.beginObject();
+            json.key("detail");
+            json.value(event.detail);
+            json.endObject();
+        }
+        json.endObject();
+    }
+    json.endArray();
+    json.key("displayTimeUnit");
+    json.value("ns");
+    json.endObject();
+    out << "\n";
+    out.flush();
+    return true;
+}
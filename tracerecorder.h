@@ -0,0 +1,102 @@
+/*!
+* \file
+* \brief Файл содержит заголовочный файл класса TraceRecorder, записывающего отрезки времени работы в формате Chrome trace-event.
+*/
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+/*!
+* \brief Класс трассировки: отрезки стадий и подшагов анализа с потоком, в котором они выполнялись.
+*
+* Результат записывается в JSON формата Chrome trace-event ("traceEvents" с событиями "X"), который открывается
+* в chrome://tracing или Perfetto. Запись событий защищена мьютексом, один объект можно разделять между потоками пакетного режима.
+*/
+class TraceRecorder
+{
+public:
+    /*!
+    * \brief Завершенный отрезок времени
+    */
+    class Event
+    {
+    public:
+        QString name; //!< имя отрезка
+        QString category; //!< категория (parse, validate, coverage, output, batch)
+        QString detail; //!< дополнительное описание (имя файла, корня), пустая строка - нет
+        qint64 startNs = 0; //!< начало от создания трассировки в наносекундах
+        qint64 durationNs = 0; //!< продолжительность в наносекундах
+        int thread = 0; //!< номер потока в порядке первого события
+    };
+
+    /*!
+    * \brief Отрезок, который записывается при выходе из области видимости; при нулевой трассировке ничего не делает
+    */
+    class Span
+    {
+    public:
+        /*!
+        * \brief Начинает отрезок
+        * \param [in] recorder - трассировка (nullptr - трассировка выключена)
+        * \param [in] name - имя отрезка
+        * \param [in] category - категория отрезка
+        * \param [in] detail - дополнительное описание
+        */
+        Span(TraceRecorder* recorder, const char* name, const char* category, const QString& detail = QString());
+
+        /*!
+        * \brief Завершает отрезок и передает его трассировке
+        */
+        ~Span();
+
+        /*!
+        * \brief Завершает отрезок раньше выхода из области видимости
+        */
+        void finish();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        TraceRecorder* recorder; //!< трассировка
+        const char* name; //!< имя отрезка
+        const char* category; //!< категория отрезка
+        QString detail; //!< дополнительное описание
+        qint64 startNs; //!< начало отрезка
+    };
+
+    /*!
+    * \brief Конструктор, начинающий отсчет времени трассировки
+    */
+    TraceRecorder();
+
+    QElapsedTimer timer; //!< таймер от создания трассировки
+    bool isDetailed; //!< записывать отрезок каждой зоны покрытия, а не только весь обход (для больших деревьев дорого)
+    QList<Event> events; //!< завершенные отрезки
+    QHash<Qt::HANDLE, int> threadIndices; //!< таблица идентификатор потока - номер потока
+    mutable QMutex mutex; //!< защита событий и таблицы потоков
+
+    /*!
+    * \brief Добавляет завершенный отрезок текущего потока
+    * \param [in] name - имя отрезка
+    * \param [in] category - категория отрезка
+    * \param [in] detail - дополнительное описание
+    * \param [in] startNs - начало отрезка в наносекундах
+    * \param [in] durationNs - продолжительность в наносекундах
+    */
+    void addEvent(const QString& name, const QString& category, const QString& detail, qint64 startNs, qint64 durationNs);
+
+    /*!
+    * \brief Записывает трассировку в файл
+    * \param [in] fileName - имя файла
+    * \return true - если файл записан, false - если его не удалось открыть
+    */
+    bool write(const QString& fileName) const;
+};
+
+#endif // TRACERECORDER_H
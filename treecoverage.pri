@@ -0,0 +1,60 @@
+# Исходные файлы анализатора покрытия без main.cpp и тестов.
+# Подключается через include() в проекты, встраивающие анализатор в другие программы.
+QT += core concurrent network
+CONFIG += c++17
+
+INCLUDEPATH += $$PWD
+
+# Пиковый объем памяти процесса в статистике запуска
+win32: LIBS += -lpsapi
+
+# Подсчет выделений памяти по стадиям в статистике и замерах: qmake "CONFIG+=allocation_profiler"
+allocation_profiler {
+    DEFINES += TREECOVERAGE_ALLOCATION_PROFILER
+}
+
+SOURCES += \
+    $$PWD/allocationprofiler.cpp \
+    $$PWD/batchanalyzer.cpp \
+    $$PWD/coveragedaemon.cpp \
+    $$PWD/coverageexporter.cpp \
+    $$PWD/coverageresult.cpp \
+    $$PWD/coveragewatcher.cpp \
+    $$PWD/differentialfuzzer.cpp \
+    $$PWD/dotgenerator.cpp \
+    $$PWD/error.cpp \
+    $$PWD/graphprofile.cpp \
+    $$PWD/jsonstreamwriter.cpp \
+    $$PWD/node.cpp \
+    $$PWD/resourcelimits.cpp \
+    $$PWD/revisionstate.cpp \
+    $$PWD/resultcache.cpp \
+    $$PWD/runstatistics.cpp \
+    $$PWD/sharedtree.cpp \
+    $$PWD/tracerecorder.cpp \
+    $$PWD/treecoverageanalyzer.cpp
+
+HEADERS += \
+    $$PWD/allocationprofiler.h \
+    $$PWD/batchanalyzer.h \
+    $$PWD/boundedqueue.h \
+    $$PWD/coveragedaemon.h \
+    $$PWD/coverageengine.h \
+    $$PWD/coverageexporter.h \
+    $$PWD/coveragepolicies.h \
+    $$PWD/coverageresult.h \
+    $$PWD/coveragewatcher.h \
+    $$PWD/differentialfuzzer.h \
+    $$PWD/dotgenerator.h \
+    $$PWD/error.h \
+    $$PWD/graphprofile.h \
+    $$PWD/jsonstreamwriter.h \
+    $$PWD/node.h \
+    $$PWD/resourcelimits.h \
+    $$PWD/revisionstate.h \
+    $$PWD/resultcache.h \
+    $$PWD/runstatistics.h \
+    $$PWD/sharedtree.h \
+    $$PWD/topcandidates.h \
+    $$PWD/tracerecorder.h \
+    $$PWD/treecoverageanalyzer.h
@@ -3,8 +3,108 @@
 * \brief Файл содержит реализацию функций, использующихся в ходе работы программы GetConclusionAboutNodeCoverage.
 */
 #include "treecoverageanalyzer.h"
+#include "coverageengine.h"
+#include "topcandidates.h"
+#include <QtConcurrent>
+#include <QPromise>
+#include <QCryptographicHash>
+#include <algorithm>
 
-TreeCoverageAnalyzer::TreeCoverageAnalyzer() {
+/*!
+* \brief Считает размер текста в кодировке UTF-8 без создания копии
+* \param [in] content - текст
+* \return количество байт
+*/
+static qint64 utf8Size(QStringView content) {
+    qint64 size = 0;
+    for (const QChar character : content) {
+        const ushort code = character.unicode();
+        if (code < 0x80) {
+            size += 1;
+        }
+        else if (code < 0x800) {
+            size += 2;
+        }
+        else if (character.isHighSurrogate()) {
+            size += 4; // Суррогатная пара кодируется четырьмя байтами, младшая половина не добавляет байт
+        }
+        else if (!character.isLowSurrogate()) {
+            size += 3;
+        }
+    }
+    return size;
+}
+
+/*!
+* \brief Действия анализатора при обходе CoverageEngine: прогресс и отмена, счетчики посещений,
+* перенос результатов неизменных поддеревьев предыдущей ревизии и статусы узлов зоны недостающих узлов.
+* При подробной трассировке каждая зона недостающих и избыточных узлов записывается отдельным отрезком
+*/
+class AnalyzerCoverageHooks
+{
+public:
+    TreeCoverageAnalyzer* analyzer = nullptr; //!< анализатор, для которого выполняется обход
+    QVector<QPair<int, qint64>> zoneStarts; //!< начатые отрезки зон при подробной трассировке: узел, начавший зону, и время начала
+
+    template <typename Engine>
+    bool visit(Engine& engine, int node, typename Engine::Zone zone) {
+        static const TreeCoverageAnalyzer::TraversalFunction functions[] = {TreeCoverageAnalyzer::ExtraZoneTraversal,
+                                                                            TreeCoverageAnalyzer::MissingZoneTraversal,
+                                                                            TreeCoverageAnalyzer::RedundantZoneTraversal};
+        if (!analyzer->countProgress(TreeCoverageAnalyzer::CoverageStage)) {
+            return false;
+        }
+        analyzer->visitCounts[functions[zone]]++;
+
+        // Зону начинают целевой узел вне зоны недостающих узлов и отмеченный узел в зоне лишних узлов
+        if (analyzer->trace && analyzer->trace->isDetailed) {
+            const Node::Shape shape = engine.tree.shape(node);
+            if ((zone == Engine::ExtraZone && shape != Node::Base) || (zone == Engine::RedundantZone && shape == Node::Target)) {
+                zoneStarts.append(qMakePair(node, analyzer->trace->timer.nsecsElapsed()));
+            }
+        }
+        return true;
+    }
+
+    template <typename Engine>
+    bool reuse(Engine& engine, int node, typename Engine::Status& status) {
+        return analyzer->previousState && analyzer->reuseCoverage(engine.tree.nodes[node], status);
+    }
+
+    template <typename Engine>
+    void leave(Engine& engine, int node, typename Engine::Zone zone, typename Engine::Status status) {
+        if (zone == Engine::MissingZone) {
+            analyzer->nodeStatuses[engine.tree.nodes[node]] = status;
+        }
+        if (!zoneStarts.isEmpty() && zoneStarts.last().first == node) {
+            const qint64 startNs = zoneStarts.takeLast().second;
+            const bool isTarget = engine.tree.shape(node) == Node::Target;
+            analyzer->trace->addEvent(isTarget ? "analyzeZoneWithMissingNodes" : "analyzeZoneWithRedundantNodes", "coverage",
+                                      engine.tree.nodes[node]->name, startNs, analyzer->trace->timer.nsecsElapsed() - startNs);
+        }
+    }
+};
+
+/*!
+* \brief Вариант CoverageEngine, которым анализатор обходит дерево: исходные узлы, QSet и рекурсия, как в ReferenceCoverageEngine
+*/
+typedef CoverageEngine<PointerTreePolicy, HashSetPolicy, RecursiveTraversal, AnalyzerCoverageHooks> AnalyzerCoverageEngine;
+
+/*!
+* \brief Добавляет найденные при обходе узлы к результату анализатора
+* \param [in,out] analyzer - анализатор
+* \param [in] engine - завершивший обход вариант
+*/
+static void mergeEngineResult(TreeCoverageAnalyzer& analyzer, const AnalyzerCoverageEngine& engine) {
+    analyzer.extraNodes.unite(engine.nodeSet(engine.extraNodes));
+    analyzer.missingNodes.unite(engine.nodeSet(engine.missingNodes));
+    analyzer.redundantNodes.unite(engine.redundantNodeSet());
+}
+
+TreeCoverageAnalyzer::TreeCoverageAnalyzer()
+    : ownsNodes(true), previousState(nullptr), suggestionCount(0), resultFileName("coverage_result.txt"), resultFormat(TextFormat),
+      isCanceled(false), progressCounter(0), resultCache(nullptr), statistics(nullptr), trace(nullptr), limits(nullptr),
+      isLimitExceeded(false), limitInputBytes(0) {
     clearData();
 }
 
@@ -53,16 +153,46 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
         errors.append(Error(Error::EmptyFile));
         return;
     }
+    restartLimits();
+    const qint64 inputBytes = utf8Size(content);
+    if (limits && limits->maxInputBytes > 0 && inputBytes > limits->maxInputBytes) {
+        exceedLimit(QString("размер входных данных %1 больше %2 байт").arg(inputBytes).arg(limits->maxInputBytes));
+        return;
+    }
+    limitInputBytes = content.size() * static_cast<qint64>(sizeof(QChar));
+    if (limits && !checkGraphLimits(0, 0)) {
+        return;
+    }
+
+    // Прогресс разбора измеряется в байтах UTF-8: текст просматривается тремя проходами (узлы, ребра,
+    // ненаправленные ребра), каждый из которых составляет треть общего объема. Байты до позиции совпадения
+    // досчитываются от предыдущего сообщения, поэтому весь проход пересчитывает текст один раз
+    qint64 passBytes = 0;
+    qsizetype passPosition = 0;
+    auto reportParsed = [&](int pass, qsizetype position) {
+        passBytes += utf8Size(QStringView(content).mid(passPosition, position - passPosition));
+        passPosition = position;
+        return reportProgress(ParsingStage, pass * inputBytes + passBytes, 3 * inputBytes);
+    };
+    auto startPass = [&]() {
+        passBytes = 0;
+        passPosition = 0;
+    };
 
     // Собираем все имена узлов и их атрибуты
+    TraceRecorder::Span nodePass(trace, "node regex pass", "parse");
     QRegularExpression nodeRegex(R"((\w+(?:,\w+)*)\s*\[(.*?)\]\s*;|(\w+(?:,\w+)*)\s*;)");
     QRegularExpressionMatchIterator nodeIter = nodeRegex.globalMatch(content);
     QStringList nodeNames;
     QMap<QString, QString> nodeAttributes; // Для хранения атрибутов
 
     // Обработка узлов
+    qint64 matchCount = 0;
     while (nodeIter.hasNext()) {
         QRegularExpressionMatch match = nodeIter.next();
+        if (++matchCount % ProgressInterval == 0 && !reportParsed(0, match.capturedEnd())) {
+            return;
+        }
         QString nodeList = match.captured(1).isEmpty() ? match.captured(3) : match.captured(1);
         QString attributesStr = match.captured(2);
         QStringList nodes = nodeList.split(',');
@@ -70,6 +200,9 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
             QString trimmedName = name.trimmed();
             if (!nodeNames.contains(trimmedName)) {
                 nodeNames.append(trimmedName);
+                if (limits && !checkGraphLimits(nodeNames.size(), 0)) {
+                    return;
+                }
             }
             if (!attributesStr.isEmpty()) {
                 nodeAttributes[trimmedName] = attributesStr;
@@ -77,14 +210,21 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
         }
     }
 
+    nodePass.finish();
+
     // Сортируем имена узлов для детерминированного порядка
+    TraceRecorder::Span symbolTable(trace, "symbol table build", "parse");
     nodeNames.sort();
 
     bool hasTargetNode = false;
     QHash<QString, Node*> nodeNameMap;
 
-    // Создаём узлы
+    // Создаём узлы (прогресс остается на конце первого прохода, но отмена проверяется)
+    qint64 createdCount = 0;
     for (const QString& name : nodeNames) {
+        if (++createdCount % ProgressInterval == 0 && !reportProgress(ParsingStage, inputBytes, 3 * inputBytes)) {
+            return;
+        }
         Node::Shape nodeShape = Node::Base;
         bool shapeValid = true;
         QString attributesStr = nodeAttributes.value(name);
@@ -148,11 +288,19 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
         nodeNameMap[name] = node;
     }
 
+    symbolTable.finish();
+
     // Обработка рёбер (остальной код остаётся без изменений)
+    TraceRecorder::Span edgePass(trace, "edge regex pass", "parse");
     QRegularExpression edgeRegex(R"((\w+)\s*->\s*(\w+)\s*(?:\[([^\]]+)\])?\s*;)");
     QRegularExpressionMatchIterator edgeIter = edgeRegex.globalMatch(content);
+    qint64 edgeCount = 0;
+    startPass();
     while (edgeIter.hasNext()) {
         QRegularExpressionMatch match = edgeIter.next();
+        if (++matchCount % ProgressInterval == 0 && !reportParsed(1, match.capturedEnd())) {
+            return;
+        }
         QString parentName = match.captured(1);
         QString childName = match.captured(2);
         QString edgeAttrsStr = match.captured(3);
@@ -173,6 +321,9 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
 
         parent->children.append(child);
         amountOfParents[child] = amountOfParents.value(child, 0) + 1;
+        if (limits && !checkGraphLimits(treeMap.size(), ++edgeCount)) {
+            return;
+        }
 
         if (!edgeAttrsStr.isEmpty()) {
             QRegularExpression attrRegex(R"(\s*label\s*=\s*(\w+|"[^"]*"|'[^']*')\s*)");
@@ -186,13 +337,20 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
         }
     }
 
+    edgePass.finish();
+
     // Обработка ненаправленных рёбер (без изменений)
+    TraceRecorder::Span undirectedPass(trace, "undirected edge regex pass", "parse");
     QRegularExpression undirectedEdgeRegex(R"((\w+)\s*--\s*(\w+)\s*(?:\[([^\]]+)\])?\s*;)");
     QRegularExpressionMatchIterator undirectedIter = undirectedEdgeRegex.globalMatch(content);
     bool hasUndirected = false;
+    startPass();
     while (undirectedIter.hasNext()) {
         hasUndirected = true;
         QRegularExpressionMatch match = undirectedIter.next();
+        if (++matchCount % ProgressInterval == 0 && !reportParsed(2, match.capturedEnd())) {
+            return;
+        }
         QString node1Name = match.captured(1);
         QString node2Name = match.captured(2);
         QString edgeAttrsStr = match.captured(3);
@@ -215,6 +373,10 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
         node2->children.append(node1);
         amountOfParents[node2] = amountOfParents.value(node2, 0) + 1;
         amountOfParents[node1] = amountOfParents.value(node1, 0) + 1;
+        edgeCount += 2;
+        if (limits && !checkGraphLimits(treeMap.size(), edgeCount)) {
+            return;
+        }
 
         if (!edgeAttrsStr.isEmpty()) {
             QRegularExpression attrRegex(R"(\s*label\s*=\s*(\w+|"[^"]*"|'[^']*')\s*)");
@@ -228,6 +390,8 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
         }
     }
 
+    undirectedPass.finish();
+
     if (hasUndirected) {
         errors.append(Error(Error::UndirectedEdge));
     }
@@ -239,8 +403,14 @@ void TreeCoverageAnalyzer::parseDOT(const QString& content) {
 }
 
 void TreeCoverageAnalyzer::clearData(){
-    // Очищаем treeMap и освобождаем память
-    qDeleteAll(treeMap);
+    // Удаляем анализаторы компонент леса (узлами они не владеют)
+    qDeleteAll(forest);
+    forest.clear();
+
+    // Очищаем treeMap и освобождаем память, если узлы принадлежат этому анализатору
+    if (ownsNodes) {
+        qDeleteAll(treeMap);
+    }
     treeMap.clear();
 
     // Очищаем остальные поля
@@ -253,13 +423,75 @@ void TreeCoverageAnalyzer::clearData(){
     extraNodes.clear();
     redundantNodes.clear();
     errors.clear();
+    subtreeHashes.clear();
+    subtreeIntervals.clear();
+    nodeStatuses.clear();
+    reusableSubtrees.clear();
+    previousToCurrent.clear();
+    reusedSubtrees.clear();
+    changedNodes.clear();
+    addedNodes.clear();
+    removedNodeNames.clear();
+    previousState = nullptr;
+    reusedSubtreeCount = 0;
+    uncoveredLeafCounts.clear();
+    suggestedNodes.clear();
+
+    // Сбрасываем счетчики посещений и флаги
+    visitCounts.fill(0, TraversalFunctionCount);
+    isConnected = false;
+    isCanceled = false;
+    isLimitExceeded = false;
+    progressCounter = 0;
+}
+
+void TreeCoverageAnalyzer::clearCoverage(){
+    missingNodes.clear();
+    extraNodes.clear();
+    redundantNodes.clear();
+    nodeStatuses.clear();
+    uncoveredLeafCounts.clear();
+    suggestedNodes.clear();
+}
 
+bool TreeCoverageAnalyzer::selectNodes(const QStringList& names, QStringList& invalidNames){
+    QHash<QString, Node*> nodes;
+    for (Node* node : treeMap) {
+        nodes.insert(node->name, node);
+    }
 
-    // Сбрасываем флаги
-    isConnected = false;
+    // 1. Проверяем имена до изменения отметок, чтобы ошибка не оставила дерево в промежуточном состоянии
+    QSet<Node*> selection;
+    invalidNames.clear();
+    for (const QString& name : names) {
+        Node* node = nodes.value(name, nullptr);
+        if (node == nullptr || node->shape == Node::Target) {
+            invalidNames.append(name);
+        }
+        else {
+            selection.insert(node);
+        }
+    }
+    if (!invalidNames.isEmpty()) {
+        return false;
+    }
+
+    // 2. Переставляем отметки нецелевых узлов
+    for (Node* node : treeMap) {
+        if (node->shape != Node::Target) {
+            node->shape = selection.contains(node) ? Node::Selected : Node::Base;
+        }
+    }
+    return true;
 }
 
 void TreeCoverageAnalyzer::fillHash(QList<Node*>& treeMap, QHash<Node*, int>& amountOfParents){
+    TraceRecorder::Span span(trace, "fillHash", "validate");
+    progressCounter = 0;
+    if (statistics) {
+        statistics->startPhase("fillHash");
+    }
+
     // 1. Инициализируем хэш-таблицу, устанавливая количество родителей в 0 для каждого узла
     for (Node* node : treeMap) {
         amountOfParents[node] = 0; // Для каждого отдельного узла заполняем кол-во родителей
@@ -273,7 +505,14 @@ void TreeCoverageAnalyzer::fillHash(QList<Node*>& treeMap, QHash<Node*, int>& am
     }
 
     // 3. Проверяем связанность графа, наличие узлов с несколькими родителями и наличие циклов в графе
+    if (statistics) {
+        statistics->startPhase("validation");
+    }
     treeGraphTakeErrors(amountOfParents);
+    if (statistics) {
+        statistics->stopPhase();
+        statistics->countVisits(*this);
+    }
 }
 
 void TreeCoverageAnalyzer::treeGraphTakeErrors(QHash<Node*, int>& amountOfParents){
@@ -301,14 +540,19 @@ void TreeCoverageAnalyzer::treeGraphTakeErrors(QHash<Node*, int>& amountOfParent
     // 3. Проверяем цикличность и собираем посещенные узлы
     QSet<QSet<Node*>> allVisitedNodes;
     for (Node* root : rootNodes) {
+        TraceRecorder::Span rootSpan(trace, "hasCycles", "validate", root->name);
         QList<Node*> currentPath;
         hasCycles(root, currentPath);
         allVisitedNodes.insert(visitedNodes);
         visitedNodes.clear();
     }
+    if (isLimitExceeded) {
+        return; // Обход остановлен, связность по неполному обходу не проверяется
+    }
 
     // 4. Проверяем связанность графа
     // Проверяем связанность графа
+    TraceRecorder::Span connectivitySpan(trace, "connectivity check", "validate");
     isConnected = !allVisitedNodes.isEmpty();
     if (isConnected) {
         // Проверяем наличие общих узлов
@@ -367,6 +611,16 @@ void TreeCoverageAnalyzer::hasCycles(Node* node, QList<Node*>& currentPath) {
         return;
     }
 
+    // Если проверка отменена, прекратить обход
+    if (!countProgress(ValidationStage)) {
+        return;
+    }
+    visitCounts[HasCyclesTraversal]++;
+    if (limits && limits->maxDepth > 0 && currentPath.size() > limits->maxDepth) {
+        exceedLimit(QString("глубина узла %1 больше %2").arg(node->name).arg(limits->maxDepth));
+        return;
+    }
+
     // 3. Добавить текущий узел в currentPath и visitedNodes
     currentPath.append(node);
     visitedNodes.insert(node);
@@ -383,175 +637,294 @@ void TreeCoverageAnalyzer::hasCycles(Node* node, QList<Node*>& currentPath) {
 void TreeCoverageAnalyzer::analyzeTreeCoverage(){
     // Проверяем что граф соответсвует дереву
     if(errors.isEmpty()){
-        Node* root = *rootNodes.begin(); // Так как граф соответствует дереву, понимаем что корень у дерева всего лишь один
-        analyzeZoneWithExtraNodes(root); // Вызываем анализ зоны с возможными лишними узлами
+        if (statistics) {
+            statistics->startPhase("analyzeTreeCoverage");
+        }
+        analyzeCoverage();
     }
 
+    if (statistics) {
+        statistics->countVisits(*this);
+        statistics->startPhase("getResult");
+    }
     getResult(); // Формуруем результат
+    if (statistics) {
+        statistics->stopPhase();
+    }
 }
 
-void TreeCoverageAnalyzer::analyzeZoneWithExtraNodes(Node* node){
-    // 1 Если текущий узел равен NULL, вернуться
-    if (!node) {
-        return;
+void TreeCoverageAnalyzer::analyzeCoverage(){
+    progressCounter = 0;
+    Node* root = *rootNodes.begin(); // Так как граф соответствует дереву, понимаем что корень у дерева всего лишь один
+    {
+        // Один отрезок на весь обход, посещения зон записываются в его описание
+        TraceRecorder::Span span(trace, "analyzeZoneWithExtraNodes", "coverage", root->name);
+        const QVector<qint64> visitsBefore = visitCounts;
+        analyzeZoneWithExtraNodes(root); // Вызываем анализ зоны с возможными лишними узлами
+        if (trace) {
+            span.detail = QString("%1: посещено узлов в зонах лишних %2, недостающих %3, избыточных %4").arg(root->name)
+                              .arg(visitCounts[ExtraZoneTraversal] - visitsBefore[ExtraZoneTraversal])
+                              .arg(visitCounts[MissingZoneTraversal] - visitsBefore[MissingZoneTraversal])
+                              .arg(visitCounts[RedundantZoneTraversal] - visitsBefore[RedundantZoneTraversal]);
+        }
     }
-
-    // 2 Если текущий узел имеет тип Target
-    if (node->shape == Node::Target) {
-        // 2.1 Вызвать analyzeZoneWithMissingNodes для этого узла
-        analyzeZoneWithMissingNodes(node);
-        // 2.2 Вернуться из функции
-        return;
+    if (!isCanceled) {
+        TraceRecorder::Span span(trace, "suggestMarks", "coverage");
+        suggestedNodes = suggestMarks(suggestionCount); // Подбираем узлы с наибольшим приростом покрытия
     }
+}
 
-    // 3 Если текущий узел имеет тип Selected и до этого не был встречен целевой узел
-    if (node->shape == Node::Selected) {
-        // 3.1 Добавить его в список extraNodes
-        extraNodes.insert(node);
-        // 3.2 Для каждого дочернего узла вызвать analyzeZoneWithRedundantNodes
-        for (Node* child : node->children) {
-            analyzeZoneWithRedundantNodes(child, node);
+CoverageResult TreeCoverageAnalyzer::analyze(const QString& content){
+    // 1. Парсинг DOT-контента
+    CoverageResult::Status status = CoverageResult::ParseErrors;
+    parseDOT(content);
+    const bool isParsed = !isCanceled && errors.isEmpty();
+
+    // 2. Результат для той же структуры и тех же отметок берется из кэша без проверки и обхода дерева
+    QByteArray cacheKey;
+    if (isParsed && resultCache) {
+        cacheKey = ResultCache::key(structureHash(), *this);
+        CoverageResult cached;
+        if (resultCache->find(cacheKey, cached)) {
+            applyResult(cached);
+            return cached;
         }
-        // 3.3 Вернуться из рекурсии
-        return;
     }
 
-    // 4 Для каждого дочернего узла
-    for (Node* child : node->children) {
-        // 4.1 Рекурсивно обойти часть дерева до целевого узла
-        analyzeZoneWithExtraNodes(child);
+    // 3. Проверка графа и анализ покрытия
+    if (isParsed && validateGraph(status)) {
+        status = analyzeValidTree();
     }
-}
 
-TreeCoverageAnalyzer::CoverageStatus TreeCoverageAnalyzer::analyzeZoneWithMissingNodes(Node* node) {
-    // 1. Если текущий узел равен NULL, вернуть NotCovered
-    if (!node) {
-        return NotCovered;
+    // Результат прерванного анализа неполон, поэтому возвращается только итог, а при превышении ограничений - ошибки
+    if (isLimitExceeded) {
+        return buildResult(CoverageResult::LimitExceeded);
+    }
+    if (isCanceled) {
+        CoverageResult result;
+        result.status = CoverageResult::Canceled;
+        return result;
+    }
+    const CoverageResult result = buildResult(status);
+    if (isParsed && resultCache) {
+        resultCache->insert(cacheKey, result);
     }
+    return result;
+}
 
-    // 2. Если узел имеет тип Target
-    if (node->shape == Node::Shape::Target) {
-        // Если у целевого узла нет детей, возвращаем PartiallyCovered
-        if (node->children.isEmpty()) {
-            return PartiallyCovered;
-        }
+bool TreeCoverageAnalyzer::validate(const QString& content, CoverageResult::Status& status){
+    // 1. Парсинг DOT-контента
+    parseDOT(content);
+    if (isCanceled) {
+        status = isLimitExceeded ? CoverageResult::LimitExceeded : CoverageResult::Canceled;
+        return false;
+    }
+    if (!errors.isEmpty()) {
+        status = CoverageResult::ParseErrors;
+        return false;
+    }
 
-        // 2.1. Рекурсивно проверить всех детей
-        bool allChildrenFullyCovered = true;
-        for (Node* child : node->children) {
-            CoverageStatus childStatus = analyzeZoneWithMissingNodes(child);
-            // 2.2. Если хотя бы один ребенок не FullyCovered, устанавливаем флаг в false
-            if (childStatus != FullyCovered) {
-                allChildrenFullyCovered = false;
-            }
-        }
+    // 2. Проверка что граф является деревом
+    return validateGraph(status);
+}
 
-        // 2.2.1. Если все дети FullyCovered, вернуть FullyCovered
-        if (allChildrenFullyCovered) {
-            return FullyCovered;
-        }
-        // 2.3. Иначе вернуть PartiallyCovered
-        return PartiallyCovered;
+bool TreeCoverageAnalyzer::validateGraph(CoverageResult::Status& status){
+    fillHash(treeMap, amountOfParents);
+    if (isCanceled) {
+        status = isLimitExceeded ? CoverageResult::LimitExceeded : CoverageResult::Canceled;
+        return false;
     }
+    if (!errors.isEmpty()) {
+        status = CoverageResult::GraphErrors;
+        return false;
+    }
+    return true;
+}
 
-    // 3. Если узел имеет тип Selected
-    else if (node->shape == Node::Shape::Selected) {
-        // 3.1. Для всех потомков вызвать analyzeZoneWithRedundantNodes
-        for (Node* child : node->children) {
-            analyzeZoneWithRedundantNodes(child, node);
-        }
-        // 3.2. Вернуть FullyCovered
-        return FullyCovered;
+void TreeCoverageAnalyzer::applyResult(const CoverageResult& result){
+    QHash<QString, Node*> nodes;
+    for (Node* node : treeMap) {
+        nodes.insert(node->name, node);
     }
 
-    // 4. Иначе (узел типа Base)
-    else {
-        // Если узел не имеет детей, он считается NotCovered, и добавляем его в missingNodes
-        if (node->children.isEmpty()) {
-            missingNodes.insert(node);
-            return NotCovered;
-        }
+    clearCoverage();
+    errors.clear();
+    for (const Error& error : result.errors) {
+        errors.append(Error(error.type, error.details));
+    }
+    for (const QString& name : result.extraNodes) {
+        extraNodes.insert(nodes.value(name));
+    }
+    for (const QString& name : result.missingNodes) {
+        missingNodes.insert(nodes.value(name));
+    }
+    for (const QPair<QString, QString>& pair : result.redundantNodes) {
+        redundantNodes.insert(qMakePair(nodes.value(pair.first), nodes.value(pair.second)));
+    }
+    for (const QPair<QString, int>& suggestion : result.suggestedNodes) {
+        suggestedNodes.append(qMakePair(nodes.value(suggestion.first), suggestion.second));
+    }
+}
 
-        bool allFullyCovered = true;
-        bool allNotCovered = true;
-        bool hasFullyOrPartiallyCovered = false;
-        QSet<Node*> notCoveredChildren;
+CoverageResult::Status TreeCoverageAnalyzer::analyzeValidTree(){
+    analyzeCoverage();
+    if (isCanceled) {
+        return isLimitExceeded ? CoverageResult::LimitExceeded : CoverageResult::Canceled;
+    }
+    const bool covered = extraNodes.isEmpty() && redundantNodes.isEmpty() && missingNodes.isEmpty();
+    return covered ? CoverageResult::Covered : CoverageResult::NotCovered;
+}
 
-        // 4.1. Проверяем всех детей
-        for (Node* child : node->children) {
-            CoverageStatus childStatus = analyzeZoneWithMissingNodes(child);
-            if (childStatus == FullyCovered) {
-                allNotCovered = false;
-                hasFullyOrPartiallyCovered = true;
+QFuture<CoverageResult> TreeCoverageAnalyzer::analyzeAsync(const QString& content, int suggestionCount, QThreadPool* pool){
+    return QtConcurrent::run(pool, [content, suggestionCount](QPromise<CoverageResult>& promise) {
+        const int stageStart[] = {0, 500, 800};
+        const int stageWidth[] = {500, 300, 200};
+        promise.setProgressRange(0, 1000);
+
+        // Анализатор создается в потоке пула и удаляется вместе со своими узлами до возврата результата
+        TreeCoverageAnalyzer analyzer;
+        analyzer.suggestionCount = suggestionCount;
+        analyzer.progressHandler = [&](AnalysisStage stage, qint64 done, qint64 total) {
+            const qint64 boundedDone = qMin(done, total);
+            const int value = stageStart[stage] + (total > 0 ? static_cast<int>(stageWidth[stage] * boundedDone / total) : 0);
+            QString text;
+            if (stage == ParsingStage) {
+                // Разбор состоит из трех проходов по тексту, в тексте показывается текущий проход
+                const qint64 passTotal = total / 3;
+                const qint64 pass = passTotal > 0 ? qMin<qint64>(2, boundedDone / passTotal) : 0;
+                text = QString("Разбор, проход %1 из 3: %2 из %3 байт").arg(pass + 1).arg(boundedDone - pass * passTotal).arg(passTotal);
             }
-            else if (childStatus == PartiallyCovered) {
-                allFullyCovered = false;
-                allNotCovered = false;
-                hasFullyOrPartiallyCovered = true;
+            else if (stage == ValidationStage) {
+                text = QString("Проверка: %1 из %2 узлов").arg(boundedDone).arg(total);
             }
-            else if (childStatus == NotCovered) {
-                allFullyCovered = false;
-                notCoveredChildren.insert(child);
+            else {
+                text = QString("Анализ покрытия: %1 из %2 узлов").arg(boundedDone).arg(total);
             }
+            promise.setProgressValueAndText(value, text);
+            return !promise.isCanceled();
+        };
+
+        // Отмененный будущий результат не принимает значений, поэтому результат отмены не добавляется
+        const CoverageResult result = analyzer.analyze(content);
+        if (promise.isCanceled()) {
+            return;
         }
+        promise.setProgressValueAndText(1000, "Анализ завершен");
+        promise.addResult(result);
+    });
+}
 
-        // 4.1. Если все дети FullyCovered
-        if (allFullyCovered) {
-            return FullyCovered;
-        }
+bool TreeCoverageAnalyzer::reportProgress(AnalysisStage stage, qint64 done, qint64 total){
+    // Время и память проверяются с той же частотой, что и прогресс
+    QString details;
+    if (limits && !isCanceled && !limits->checkTime(limitTimer.isValid() ? limitTimer.elapsed() : 0, details)) {
+        return exceedLimit(details);
+    }
+    if (progressHandler && !isCanceled && !progressHandler(stage, done, total)) {
+        isCanceled = true;
+    }
+    return !isCanceled;
+}
 
-        // 4.2. Если все дети NotCovered
-        if (allNotCovered) {
-            // Очищаем missingNodes от детей, добавляем текущий узел
-            for (Node* child : node->children) {
-                missingNodes.remove(child);
-            }
-            missingNodes.insert(node);
-            return NotCovered;
-        }
+bool TreeCoverageAnalyzer::countProgress(AnalysisStage stage){
+    if (++progressCounter % ProgressInterval == 0) {
+        return reportProgress(stage, progressCounter, treeMap.size());
+    }
+    return !isCanceled;
+}
 
-        // 4.3. Если хотя бы один из детей FullyCovered или PartiallyCovered
-        if (hasFullyOrPartiallyCovered) {
-            // 4.3.1. Добавить всех детей с NotCovered в missingNodes
-            missingNodes.unite(notCoveredChildren);
-            // 4.3.2. Вернуть PartiallyCovered
-            return PartiallyCovered;
-        }
+CoverageResult TreeCoverageAnalyzer::analyzeBuffer(const QByteArray& buffer){
+    return analyze(QString::fromUtf8(buffer));
+}
+
+CoverageResult TreeCoverageAnalyzer::buildResult(CoverageResult::Status status) const{
+    CoverageResult result;
+    result.status = status;
 
-        // Этот случай не должен произойти, но для полноты возвращаем NotCovered
-        return NotCovered;
+    // Ошибки копируются без ссылок на узлы, так как узлы удаляются вместе с анализатором
+    for (const Error& error : errors) {
+        result.errors.append(Error(error.type, error.details));
+    }
+    for (Node* node : treeMap) {
+        if (node->shape == Node::Target) {
+            result.targetNodes.append(node->name);
+        }
     }
+    for (Node* node : sortedByTreeOrder(extraNodes)) {
+        result.extraNodes.append(node->name);
+    }
+    for (Node* node : sortedByTreeOrder(missingNodes)) {
+        result.missingNodes.append(node->name);
+    }
+    for (const QPair<Node*, Node*>& pair : sortedRedundantNodes()) {
+        result.redundantNodes.append(qMakePair(pair.first->name, pair.second->name));
+    }
+    for (const QPair<Node*, int>& suggestion : suggestedNodes) {
+        result.suggestedNodes.append(qMakePair(suggestion.first->name, suggestion.second));
+    }
+    return result;
+}
+
+void TreeCoverageAnalyzer::analyzeZoneWithExtraNodes(Node* node){
+    AnalyzerCoverageEngine engine(QList<Node*>{node});
+    engine.hooks.analyzer = this;
+    engine.analyzeZoneWithExtraNodes(node);
+    mergeEngineResult(*this, engine);
+}
+
+TreeCoverageAnalyzer::CoverageStatus TreeCoverageAnalyzer::analyzeZoneWithMissingNodes(Node* node) {
+    AnalyzerCoverageEngine engine(QList<Node*>{node});
+    engine.hooks.analyzer = this;
+    const CoverageStatus status = engine.analyzeZoneWithMissingNodes(node);
+    mergeEngineResult(*this, engine);
+    return status;
 }
 
 void TreeCoverageAnalyzer::analyzeZoneWithRedundantNodes(Node* node, Node* selectedNode) {
-    // 1. Если текущий узел равен NULL, вернуться
-    if (!node) {
-        return;
+    AnalyzerCoverageEngine engine(QList<Node*>{node, selectedNode});
+    engine.hooks.analyzer = this;
+    engine.analyzeZoneWithRedundantNodes(node, selectedNode);
+    mergeEngineResult(*this, engine);
+}
+
+void TreeCoverageAnalyzer::getResult() const {
+    if (!writeResultFile(resultFileName)) {
+        QTextStream stderrStream(stderr);
+        stderrStream << "Ошибка: не удалось открыть файл " << resultFileName << " для записи.\n";
+        exit(1);
     }
+}
 
-    // 2. Если узел имеет тип Target
-    if (node->shape == Node::Target) {
-        // 2.1. Для каждого дочернего узла текущего узла рекурсивно вызвать analyzeZoneWithMissingNodes
-        for (Node* child : node->children) {
-            analyzeZoneWithMissingNodes(child);
+bool TreeCoverageAnalyzer::writeResultFile(const QString& fileName) const {
+    TraceRecorder::Span span(trace, "writeResultFile", "output", fileName);
+    // Открываем файл для записи
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    if (resultFormat == JsonFormat) {
+        JsonStreamWriter json(out);
+        json.beginObject();
+        writeJsonResult(json);
+        json.endObject();
+        out << "\n";
+    }
+    else if (!errors.isEmpty()) {
+        // Для дерева с ошибками записываем отчет об ошибках
+        out << "Отчет об ошибках:\n";
+        for (const Error& error : errors) {
+            out << "Ошибка: " << error.errMessage() << "\n";
         }
     }
-
-    // 3. Иначе
     else {
-        // 3.1. Если узел имеет тип Selected
-        if (node->shape == Node::Selected) {
-            // 3.1.1. Добавить его в список redundantNodes как пару (selectedNode, node)
-            redundantNodes.insert(qMakePair(selectedNode, node));
-        }
-        // 3.2. Для каждого дочернего узла вызвать analyzeZoneWithRedundantNodes
-        for (Node* child : node->children) {
-            analyzeZoneWithRedundantNodes(child, selectedNode);
-        }
+        writeResult(out);
     }
+    file.close();
+    return true;
 }
 
-void TreeCoverageAnalyzer::getResult() const {
+void TreeCoverageAnalyzer::writeResult(QTextStream& out) const {
     // Находим целевой узел
     Node* targetNode = nullptr;
     for (Node* node : treeMap) {
@@ -561,70 +934,628 @@ void TreeCoverageAnalyzer::getResult() const {
         }
     }
 
-    // Открываем файл для записи
-    QFile file("coverage_result.txt");
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream stderrStream(stderr);
-        stderrStream << "Ошибка: не удалось открыть файл coverage_result.txt для записи.\n";
-        exit(1);
-    }
-    QTextStream out(&file);
-
     bool hasErrors = false;
 
     // 1. Проверка наличия лишних узлов (узлы, не являющиеся потомками целевого узла)
     if (!extraNodes.isEmpty()) {
-        QString extraNodeNames;
-        for (Node* node : extraNodes) {
-            extraNodeNames += node->name + " ";
+        out << "Отмеченный узел ";
+        bool first = true;
+        for (Node* node : sortedByTreeOrder(extraNodes)) {
+            out << (first ? "" : " ") << node->name;
+            first = false;
         }
-        extraNodeNames = extraNodeNames.trimmed();
-        out << QString("Отмеченный узел %1 не является потомком целевого узла %2.\n").arg(extraNodeNames, targetNode->name);
+        out << " не является потомком целевого узла " << targetNode->name << ".\n";
         hasErrors = true;
     }
 
     // 2. Проверка наличия избыточных узлов (redundantNodes)
     if (!redundantNodes.isEmpty()) {
-        QString ancestorNodeNames;
-        QString redundantNodeNames;
-        for (const QPair<Node*, Node*>& pair : redundantNodes) {
-            Node* ancestor = pair.first;
-            Node* descendant = pair.second;
-            ancestorNodeNames += ancestor->name + " ";
-            redundantNodeNames += descendant->name + " ";
-        }
-        redundantNodeNames = redundantNodeNames.trimmed();
-        out << QString("Предок %1 отмеченного узла %2 тоже отмечен, следует не отмечать детей, если отмечен их предок.\n").arg(ancestorNodeNames, redundantNodeNames);
+        const QList<QPair<Node*, Node*>> redundantPairs = sortedRedundantNodes();
+        out << "Предок ";
+        for (const QPair<Node*, Node*>& pair : redundantPairs) {
+            out << pair.first->name << " ";
+        }
+        out << " отмеченного узла ";
+        bool first = true;
+        for (const QPair<Node*, Node*>& pair : redundantPairs) {
+            out << (first ? "" : " ") << pair.second->name;
+            first = false;
+        }
+        out << " тоже отмечен, следует не отмечать детей, если отмечен их предок.\n";
         hasErrors = true;
     }
 
     // 3. Проверка наличия узлов, которых не хватает для покрытия (missingNodes)
     if (!missingNodes.isEmpty()) {
-        QString missingNodeNames;
-        for (Node* node : missingNodes) {
-            missingNodeNames += node->name + " ";
+        out << "Узел " << targetNode->name << " – не покрыт, следует отметить узлы ";
+        bool first = true;
+        for (Node* node : sortedByTreeOrder(missingNodes)) {
+            out << (first ? "" : " ") << node->name;
+            first = false;
         }
-        missingNodeNames = missingNodeNames.trimmed();
-        out << QString("Узел %1 – не покрыт, следует отметить узлы %2 для того чтобы узел %1 стал покрытым.\n").arg(targetNode->name, missingNodeNames);
+        out << " для того чтобы узел " << targetNode->name << " стал покрытым.\n";
         hasErrors = true;
     }
 
+    // 3.1. Узлы, отметка которых даст наибольший прирост покрытия
+    if (!suggestedNodes.isEmpty()) {
+        QStringList suggestions;
+        for (const QPair<Node*, int>& suggestion : suggestedNodes) {
+            suggestions.append(QString("%1 (листьев: %2)").arg(suggestion.first->name).arg(suggestion.second));
+        }
+        out << QString("Наибольший прирост покрытия дадут отметки узлов: %1.\n").arg(suggestions.join(", "));
+    }
+
     // 4. Если ошибок нет, возвращаем сообщение об успешном покрытии
     if (!hasErrors) {
-        QString selectedNodeNames;
+        bool hasSelected = false;
         for (Node* node : treeMap) {
             if (node->shape == Node::Selected) {
-                selectedNodeNames += node->name + " ";
+                out << (hasSelected ? " " : "Помеченные узлы ") << node->name;
+                hasSelected = true;
             }
         }
-        selectedNodeNames = selectedNodeNames.trimmed();
-        if (selectedNodeNames.isEmpty()) {
-            out << QString("Целевой узел %1 покрыт.\n").arg(targetNode->name);
+        if (!hasSelected) {
+            out << "Целевой узел " << targetNode->name << " покрыт.\n";
         }
         else {
-            out << QString("Помеченные узлы %1 покрывают вышележащий узел %2.\n").arg(selectedNodeNames, targetNode->name);
+            out << " покрывают вышележащий узел " << targetNode->name << ".\n";
         }
     }
+}
+
+void TreeCoverageAnalyzer::writeJsonResult(JsonStreamWriter& json) const {
+    const QList<Node*> sortedExtraNodes = sortedByTreeOrder(extraNodes);
+    const QList<QPair<Node*, Node*>> redundantPairs = sortedRedundantNodes();
+    const QList<Node*> sortedMissingNodes = sortedByTreeOrder(missingNodes);
+
+    // 1. Статус и ошибки
+    json.key("status");
+    json.value(errors.isEmpty() ? "ok" : "error");
+    json.key("errors");
+    json.beginArray();
+    for (const Error& error : errors) {
+        json.beginObject();
+        json.key("type");
+        json.value(error.typeName());
+        json.key("message");
+        json.value(error.errMessage());
+        json.endObject();
+    }
+    json.endArray();
+
+    // 2. Целевые и отмеченные узлы
+    json.key("targets");
+    json.beginArray();
+    for (Node* node : treeMap) {
+        if (node->shape == Node::Target) {
+            json.value(node->name);
+        }
+    }
+    json.endArray();
+    json.key("selected");
+    json.beginArray();
+    for (Node* node : treeMap) {
+        if (node->shape == Node::Selected) {
+            json.value(node->name);
+        }
+    }
+    json.endArray();
+
+    // 3. Лишние, избыточные и недостающие узлы
+    json.key("extra");
+    json.beginArray();
+    for (Node* node : sortedExtraNodes) {
+        json.value(node->name);
+    }
+    json.endArray();
+    json.key("redundant");
+    json.beginArray();
+    for (const QPair<Node*, Node*>& pair : redundantPairs) {
+        json.beginObject();
+        json.key("ancestor");
+        json.value(pair.first->name);
+        json.key("node");
+        json.value(pair.second->name);
+        json.endObject();
+    }
+    json.endArray();
+    json.key("missing");
+    json.beginArray();
+    for (Node* node : sortedMissingNodes) {
+        json.value(node->name);
+    }
+    json.endArray();
+
+    // 4. Итог и предложения для отметки
+    json.key("covered");
+    json.value(errors.isEmpty() && extraNodes.isEmpty() && redundantNodes.isEmpty() && missingNodes.isEmpty());
+    if (!suggestedNodes.isEmpty()) {
+        json.key("suggestions");
+        json.beginArray();
+        for (const QPair<Node*, int>& suggestion : suggestedNodes) {
+            json.beginObject();
+            json.key("node");
+            json.value(suggestion.first->name);
+            json.key("leaves");
+            json.value(suggestion.second);
+            json.endObject();
+        }
+        json.endArray();
+    }
+}
+
+QList<Node*> TreeCoverageAnalyzer::sortedByTreeOrder(const QSet<Node*>& nodes) const {
+    QList<Node*> sorted;
+    if (nodes.isEmpty()) {
+        return sorted;
+    }
+    sorted.reserve(nodes.size());
+    // Один проход по treeMap дает порядок за линейное время без сортировки
+    for (Node* node : treeMap) {
+        if (nodes.contains(node)) {
+            sorted.append(node);
+        }
+    }
+    return sorted;
+}
+
+QList<QPair<Node*, Node*>> TreeCoverageAnalyzer::sortedRedundantNodes() const {
+    QList<QPair<Node*, Node*>> sorted;
+    if (redundantNodes.isEmpty()) {
+        return sorted;
+    }
+    sorted.reserve(redundantNodes.size());
+
+    // Группируем отмеченных предков по избыточному узлу и обходим избыточные узлы в порядке treeMap
+    QHash<Node*, QList<Node*>> ancestorsOf;
+    for (const QPair<Node*, Node*>& pair : redundantNodes) {
+        ancestorsOf[pair.second].append(pair.first);
+    }
+    QHash<Node*, int> ancestorOrder;
+    for (Node* node : treeMap) {
+        auto found = ancestorsOf.constFind(node);
+        if (found == ancestorsOf.constEnd()) {
+            continue;
+        }
+        QList<Node*> ancestors = found.value();
+        if (ancestors.size() > 1) {
+            // Несколько предков у одного узла встречаются редко, упорядочиваем их по treeMap
+            if (ancestorOrder.isEmpty()) {
+                for (int i = 0; i < treeMap.size(); ++i) {
+                    ancestorOrder[treeMap[i]] = i;
+                }
+            }
+            std::sort(ancestors.begin(), ancestors.end(), [&ancestorOrder](Node* first, Node* second) {
+                return ancestorOrder.value(first) < ancestorOrder.value(second);
+            });
+        }
+        for (Node* ancestor : ancestors) {
+            sorted.append(qMakePair(ancestor, node));
+        }
+    }
+    return sorted;
+}
+
+QList<QList<Node*>> TreeCoverageAnalyzer::splitIntoComponents() const {
+    // 1. Строим таблицу смежности без учета направления связей
+    QHash<Node*, QList<Node*>> neighbours;
+    for (Node* node : treeMap) {
+        for (Node* child : node->children) {
+            neighbours[node].append(child);
+            neighbours[child].append(node);
+        }
+    }
+
+    // 2. Обходом в ширину присваиваем каждому узлу номер компоненты
+    QHash<Node*, int> componentOf;
+    int componentCount = 0;
+    for (Node* start : treeMap) {
+        if (componentOf.contains(start)) {
+            continue;
+        }
+        QList<Node*> queue;
+        queue.append(start);
+        componentOf[start] = componentCount;
+        for (int i = 0; i < queue.size(); ++i) {
+            const QList<Node*> adjacent = neighbours.value(queue[i]);
+            for (Node* next : adjacent) {
+                if (!componentOf.contains(next)) {
+                    componentOf[next] = componentCount;
+                    queue.append(next);
+                }
+            }
+        }
+        componentCount++;
+    }
+
+    // 3. Раскладываем узлы по компонентам, сохраняя порядок treeMap
+    QList<QList<Node*>> components(componentCount);
+    for (Node* node : treeMap) {
+        components[componentOf.value(node)].append(node);
+    }
+    return components;
+}
+
+void TreeCoverageAnalyzer::analyzeComponent() {
+    // 1. Проверяем что компонента является деревом
+    fillHash(treeMap, amountOfParents);
+
+    // 2. В каждой компоненте должен быть свой целевой узел
+    bool hasTargetNode = false;
+    for (Node* node : treeMap) {
+        if (node->shape == Node::Target) {
+            hasTargetNode = true;
+            break;
+        }
+    }
+    if (!hasTargetNode) {
+        errors.append(Error(Error::NoTargetNode));
+    }
+
+    // 3. Анализируем покрытие, если компонента корректна
+    if (errors.isEmpty()) {
+        analyzeCoverage();
+    }
+}
+
+void TreeCoverageAnalyzer::analyzeForest() {
+    qDeleteAll(forest);
+    forest.clear();
+
+    // 1. Для каждой компоненты создаем отдельный анализатор, узлы остаются во владении текущего
+    const QList<QList<Node*>> components = splitIntoComponents();
+    for (const QList<Node*>& component : components) {
+        TreeCoverageAnalyzer* componentAnalyzer = new TreeCoverageAnalyzer();
+        componentAnalyzer->ownsNodes = false;
+        componentAnalyzer->suggestionCount = suggestionCount;
+        componentAnalyzer->trace = trace;
+        componentAnalyzer->limits = limits;
+        componentAnalyzer->limitTimer = limitTimer;
+        componentAnalyzer->treeMap = component;
+        forest.append(componentAnalyzer);
+    }
+
+    // 2. Компоненты не пересекаются по узлам, поэтому анализируем их параллельно
+    QtConcurrent::blockingMap(forest, [](TreeCoverageAnalyzer* componentAnalyzer) {
+        TraceRecorder::Span span(componentAnalyzer->trace, "analyzeComponent", "forest", componentAnalyzer->treeMap.first()->name);
+        componentAnalyzer->analyzeComponent();
+    });
+}
+
+void TreeCoverageAnalyzer::getForestResult() const {
+    // Открываем файл для записи
+    QFile file(resultFileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QTextStream stderrStream(stderr);
+        stderrStream << "Ошибка: не удалось открыть файл " << resultFileName << " для записи.\n";
+        exit(1);
+    }
+    QTextStream out(&file);
+
+    // В формате JSON выводим массив деревьев с корнями и результатами
+    if (resultFormat == JsonFormat) {
+        JsonStreamWriter json(out);
+        json.beginObject();
+        json.key("trees");
+        json.beginArray();
+        for (const TreeCoverageAnalyzer* componentAnalyzer : forest) {
+            QList<Node*> roots = componentAnalyzer->sortedByTreeOrder(componentAnalyzer->rootNodes);
+            json.beginObject();
+            json.key("roots");
+            json.beginArray();
+            for (Node* root : roots) {
+                json.value(root->name);
+            }
+            json.endArray();
+            componentAnalyzer->writeJsonResult(json);
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+        out << "\n";
+        file.close();
+        return;
+    }
+
+    // Для каждой компоненты выводим ее корень и результат проверки
+    for (const TreeCoverageAnalyzer* componentAnalyzer : forest) {
+        QStringList rootNames;
+        for (Node* root : componentAnalyzer->rootNodes) {
+            rootNames.append(root->name);
+        }
+        rootNames.sort();
+        out << QString("Дерево с корнем %1:\n").arg(rootNames.join(' '));
+
+        if (componentAnalyzer->errors.isEmpty()) {
+            componentAnalyzer->writeResult(out);
+        }
+        else {
+            for (const Error& error : componentAnalyzer->errors) {
+                out << "Ошибка: " << error.errMessage() << "\n";
+            }
+        }
+    }
+
+    file.close();
+}
+
+void TreeCoverageAnalyzer::computeSubtreeHashes() {
+    subtreeHashes.clear();
+    subtreeIntervals.clear();
+
+    // Обходим дерево от каждого корня, нумеруя узлы в порядке обхода
+    int order = 0;
+    for (Node* root : rootNodes) {
+        hashSubtree(root, order);
+    }
+}
+
+QByteArray TreeCoverageAnalyzer::hashSubtree(Node* node, int& order) {
+    const int entry = order++;
+
+    // 1. Хэшируем имя и форму узла (имя не может содержать нулевой символ, поэтому он служит разделителем)
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(node->name.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(QByteArray::number(static_cast<int>(node->shape)));
+
+    // 2. Добавляем хэши детей с сохранением их порядка
+    for (Node* child : node->children) {
+        hash.addData(hashSubtree(child, order));
+    }
+
+    // 3. Запоминаем хэш и отрезок номеров поддерева
+    const QByteArray result = hash.result();
+    subtreeHashes[node] = result;
+    subtreeIntervals[node] = qMakePair(entry, order - 1);
+    return result;
+}
+
+QByteArray TreeCoverageAnalyzer::structureHash() const {
+    // Имена узлов в порядке treeMap и списки их детей, нулевой символ разделяет имена, единичный - узлы
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (Node* node : treeMap) {
+        hash.addData(node->name.toUtf8());
+        for (Node* child : node->children) {
+            hash.addData(QByteArray(1, '\0'));
+            hash.addData(child->name.toUtf8());
+        }
+        hash.addData(QByteArray(1, '\1'));
+    }
+    return hash.result();
+}
+
+void TreeCoverageAnalyzer::diffWith(const RevisionState& previous) {
+    previousState = &previous;
+    reusableSubtrees.clear();
+    previousToCurrent.fill(nullptr, previous.size());
+    reusedSubtrees.clear();
+    changedNodes.clear();
+    addedNodes.clear();
+    removedNodeNames.clear();
+    reusedSubtreeCount = 0;
+
+    // 1. Переиспользовать можно только поддеревья, статус которых был вычислен в предыдущей ревизии
+    for (int order = 0; order < previous.size(); ++order) {
+        if (previous.statuses[order] >= 0) {
+            reusableSubtrees[previous.subtreeHashes[order]] = order;
+        }
+    }
+
+    // 2. Сопоставляем узлы ревизий по имени один раз, дальше узлы предыдущей ревизии переводятся по номеру
+    QHash<QString, int> previousOrders;
+    previousOrders.reserve(previous.size());
+    for (int order = 0; order < previous.size(); ++order) {
+        previousOrders.insert(previous.names[order], order);
+    }
+
+    // 3. Узел изменен, если изменились его форма или список детей; изменения глубже видны в самих потомках
+    for (Node* node : treeMap) {
+        auto found = previousOrders.constFind(node->name);
+        if (found == previousOrders.constEnd()) {
+            addedNodes.append(node);
+            continue;
+        }
+        const int order = found.value();
+        previousToCurrent[order] = node;
+        if (subtreeHashes.value(node) == previous.subtreeHashes[order]) {
+            continue;
+        }
+        const int childCount = previous.childOffsets[order + 1] - previous.childOffsets[order];
+        bool changed = node->shape != previous.shapes[order] || node->children.size() != childCount;
+        for (int i = 0; !changed && i < childCount; ++i) {
+            changed = node->children[i]->name != previous.names[previous.childIndices[previous.childOffsets[order] + i]];
+        }
+        if (changed) {
+            changedNodes.append(node);
+        }
+    }
+    for (int order = 0; order < previous.size(); ++order) {
+        if (!previousToCurrent[order]) {
+            removedNodeNames.append(previous.names[order]);
+        }
+    }
+}
+
+bool TreeCoverageAnalyzer::reuseCoverage(Node* node, CoverageStatus& status) {
+    // 1. Ищем такое же поддерево в предыдущей ревизии
+    auto found = reusableSubtrees.constFind(subtreeHashes.value(node));
+    if (found == reusableSubtrees.constEnd()) {
+        return false;
+    }
+    const int first = found.value();
+    const int last = previousState->subtreeEnds[first];
+    status = static_cast<CoverageStatus>(previousState->statuses[first]);
+
+    // 2. Переносим недостающие узлы, лежащие строго внутри поддерева: работа пропорциональна их количеству, а не размеру поддерева
+    const QVector<int>& missing = previousState->missingNodes;
+    for (auto it = std::upper_bound(missing.constBegin(), missing.constEnd(), first); it != missing.constEnd() && *it <= last; ++it) {
+        missingNodes.insert(previousToCurrent[*it]);
+    }
+
+    // 3. Переносим избыточные узлы, отмеченный предок которых тоже лежит внутри поддерева
+    const QVector<QPair<int, int>>& redundant = previousState->redundantNodes;
+    auto redundantBegin = std::lower_bound(redundant.constBegin(), redundant.constEnd(), first, [](const QPair<int, int>& pair, int order) {
+        return pair.second < order;
+    });
+    for (auto it = redundantBegin; it != redundant.constEnd() && it->second <= last; ++it) {
+        if (it->first >= first && it->first <= last) {
+            redundantNodes.insert(qMakePair(previousToCurrent[it->first], previousToCurrent[it->second]));
+        }
+    }
+
+    // 4. Статусы внутренних узлов нужны только для выгрузки и снимка, поэтому запоминается лишь само поддерево
+    reusedSubtrees.append(qMakePair(node, first));
+    reusedSubtreeCount++;
+    return true;
+}
+
+void TreeCoverageAnalyzer::resolveReusedStatuses() {
+    for (const QPair<Node*, int>& reused : reusedSubtrees) {
+        for (int order = reused.second + 1; order <= previousState->subtreeEnds[reused.second]; ++order) {
+            if (previousState->statuses[order] >= 0) {
+                nodeStatuses[previousToCurrent[order]] = static_cast<CoverageStatus>(previousState->statuses[order]);
+            }
+        }
+    }
+    reusedSubtrees.clear();
+}
+
+void TreeCoverageAnalyzer::getDiffResult(const QString& fileName) const {
+    // Открываем файл для записи
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QTextStream stderrStream(stderr);
+        stderrStream << "Ошибка: не удалось открыть файл " << fileName << " для записи.\n";
+        exit(1);
+    }
+    QTextStream out(&file);
+
+    if (changedNodes.isEmpty() && addedNodes.isEmpty() && removedNodeNames.isEmpty()) {
+        out << "Дерево не изменилось.\n";
+    }
+    if (!changedNodes.isEmpty()) {
+        QStringList names;
+        for (Node* node : changedNodes) {
+            names.append(node->name);
+        }
+        out << QString("Изменены поддеревья с корнями %1.\n").arg(names.join(' '));
+    }
+    if (!addedNodes.isEmpty()) {
+        QStringList names;
+        for (Node* node : addedNodes) {
+            names.append(node->name);
+        }
+        out << QString("Добавлены узлы %1.\n").arg(names.join(' '));
+    }
+    if (!removedNodeNames.isEmpty()) {
+        out << QString("Удалены узлы %1.\n").arg(removedNodeNames.join(' '));
+    }
+    out << QString("Переиспользовано поддеревьев: %1.\n").arg(reusedSubtreeCount);
 
     file.close();
 }
+
+int TreeCoverageAnalyzer::countUncoveredLeaves(Node* node) {
+    int count = 0;
+    visitCounts[UncoveredLeavesTraversal]++;
+    // 1. Под отмеченным узлом все листья уже покрыты
+    if (node->shape == Node::Selected) {
+        count = 0;
+    }
+    // 2. Лист типа Base не покрыт
+    else if (node->children.isEmpty()) {
+        count = node->shape == Node::Base ? 1 : 0;
+    }
+    // 3. Иначе суммируем непокрытые листья детей
+    else {
+        for (Node* child : node->children) {
+            count += countUncoveredLeaves(child);
+        }
+    }
+    uncoveredLeafCounts[node] = count;
+    return count;
+}
+
+QList<QPair<Node*, int>> TreeCoverageAnalyzer::suggestMarks(int k) {
+    if (k <= 0) {
+        return QList<QPair<Node*, int>>();
+    }
+
+    // Кандидат лучше, если покрывает больше листьев, при равенстве выбираем узел с меньшим именем
+    auto isBetter = [](const QPair<Node*, int>& first, const QPair<Node*, int>& second) {
+        if (first.second != second.second) {
+            return first.second > second.second;
+        }
+        return first.first->name < second.first->name;
+    };
+
+    // Недостающие узлы не пересекаются по поддеревьям, поэтому приросты их отметок складываются
+    TopCandidates<QPair<Node*, int>, decltype(isBetter)> candidates(k, isBetter);
+    for (Node* node : missingNodes) {
+        candidates.offer(qMakePair(node, countUncoveredLeaves(node)));
+    }
+    return candidates.take();
+}
+
+bool TreeCoverageAnalyzer::exceedLimit(const QString& details) {
+    if (!isLimitExceeded) {
+        errors.append(Error(Error::LimitExceeded, details));
+        isLimitExceeded = true;
+    }
+    isCanceled = true;
+    return false;
+}
+
+void TreeCoverageAnalyzer::restartLimits() {
+    if (isLimitExceeded) {
+        errors.removeAll(Error(Error::LimitExceeded));
+        isLimitExceeded = false;
+        isCanceled = false;
+    }
+    limitTimer.start();
+}
+
+bool TreeCoverageAnalyzer::checkGraphLimits(qint64 nodeCount, qint64 edgeCount) {
+    if (limits->maxNodes > 0 && nodeCount > limits->maxNodes) {
+        return exceedLimit(QString("количество узлов больше %1").arg(limits->maxNodes));
+    }
+    if (limits->maxEdges > 0 && edgeCount > limits->maxEdges) {
+        return exceedLimit(QString("количество ребер больше %1").arg(limits->maxEdges));
+    }
+
+    // Данные анализатора растут вместе с графом, поэтому память оценивается по мере разбора
+    QString details;
+    if (!limits->checkMemory(limitInputBytes, nodeCount, edgeCount, details)) {
+        return exceedLimit(details);
+    }
+    return true;
+}
+
+QString TreeCoverageAnalyzer::traversalFunctionName(TraversalFunction function) {
+    switch (function) {
+    case HasCyclesTraversal:
+        return "hasCycles";
+    case ExtraZoneTraversal:
+        return "analyzeZoneWithExtraNodes";
+    case MissingZoneTraversal:
+        return "analyzeZoneWithMissingNodes";
+    case RedundantZoneTraversal:
+        return "analyzeZoneWithRedundantNodes";
+    case UncoveredLeavesTraversal:
+        return "countUncoveredLeaves";
+    default:
+        return QString();
+    }
+}
+
+QVector<qint64> TreeCoverageAnalyzer::totalVisitCounts() const {
+    QVector<qint64> counts = visitCounts;
+    for (const TreeCoverageAnalyzer* componentAnalyzer : forest) {
+        for (int function = 0; function < TraversalFunctionCount; ++function) {
+            counts[function] += componentAnalyzer->visitCounts[function];
+        }
+    }
+    return counts;
+}
@@ -10,8 +10,22 @@
 #include <QSet>
 #include <QList>
 #include <QPair>
+#include <QMap>
+#include <QVector>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QThreadPool>
+#include <functional>
 #include "Node.h"
 #include "Error.h"
+#include "jsonstreamwriter.h"
+#include "coverageresult.h"
+#include "resourcelimits.h"
+#include "revisionstate.h"
+#include "resultcache.h"
+#include "runstatistics.h"
+#include "tracerecorder.h"
 #include <QDebug>
 #include <QFile>
 #include <QTextStream>
@@ -31,6 +45,40 @@ public:
         NotCovered
     };
 
+    /*!
+    * \brief перечисление форматов вывода результата
+    */
+    enum ResultFormat {
+        TextFormat,
+        JsonFormat
+    };
+
+    /*!
+    * \brief перечисление стадий анализа, о которых сообщается обработчику прогресса
+    */
+    enum AnalysisStage {
+        ParsingStage,
+        ValidationStage,
+        CoverageStage
+    };
+
+    /*!
+    * \brief перечисление рекурсивных функций обхода, для которых считаются посещения узлов
+    */
+    enum TraversalFunction {
+        HasCyclesTraversal,
+        ExtraZoneTraversal,
+        MissingZoneTraversal,
+        RedundantZoneTraversal,
+        UncoveredLeavesTraversal,
+        TraversalFunctionCount
+    };
+
+    /*!
+    * \brief Количество единиц работы (найденных описаний или посещенных узлов) между вызовами обработчика прогресса
+    */
+    static constexpr qint64 ProgressInterval = 1024;
+
     /*!
     * \brief конструктор по умолчанию для класса TreeCoverageAnalyzer
     */
@@ -52,6 +100,35 @@ public:
     QSet<Node*> extraNodes; //!< список лишних узлов
     QSet<QPair<Node*, Node*>> redundantNodes; //!< список избыточных узлов, представляет собой пару, где первый элемент это узел который был отмечен, а второй избыточный
     QList<Error> errors; //!< список найденных ошибок
+    bool ownsNodes; //!< поле указывает владеет ли анализатор узлами из treeMap (false у компонент леса)
+    QList<TreeCoverageAnalyzer*> forest; //!< анализаторы компонент связности в режиме леса
+    QHash<Node*, QByteArray> subtreeHashes; //!< таблица узел - хэш его поддерева (имя, форма и дети)
+    QHash<Node*, QPair<int, int>> subtreeIntervals; //!< таблица узел - отрезок порядковых номеров узлов его поддерева при обходе в глубину
+    QHash<Node*, CoverageStatus> nodeStatuses; //!< таблица узел - статус покрытия, полученный в зоне поиска недостающих узлов
+    const RevisionState* previousState; //!< снимок предыдущей ревизии дерева, результаты которого переиспользуются
+    QHash<QByteArray, int> reusableSubtrees; //!< таблица хэш поддерева - номер узла предыдущей ревизии, для которого известен статус покрытия
+    QVector<Node*> previousToCurrent; //!< узел текущей ревизии по номеру узла предыдущей (nullptr - узел удален)
+    QList<QPair<Node*, int>> reusedSubtrees; //!< переиспользованные поддеревья и номера их корней в предыдущей ревизии, статусы которых еще не восстановлены
+    QList<Node*> changedNodes; //!< узлы, в которых изменилась форма или список детей относительно предыдущей ревизии
+    QList<Node*> addedNodes; //!< узлы, которых не было в предыдущей ревизии
+    QStringList removedNodeNames; //!< имена узлов предыдущей ревизии, которых нет в текущей
+    int reusedSubtreeCount; //!< количество поддеревьев, статусы которых взяты из предыдущей ревизии
+    QHash<Node*, int> uncoveredLeafCounts; //!< таблица узел - количество непокрытых листьев в его поддереве
+    int suggestionCount; //!< количество предлагаемых для отметки узлов в выводе (0 - предложения не выводятся)
+    QList<QPair<Node*, int>> suggestedNodes; //!< предлагаемые для отметки узлы и количество листьев, которые они покроют
+    QString resultFileName; //!< имя файла, в который записывается вывод о покрытии
+    ResultFormat resultFormat; //!< формат вывода о покрытии
+    std::function<bool(AnalysisStage stage, qint64 done, qint64 total)> progressHandler; //!< обработчик прогресса, возвращает false для отмены анализа
+    bool isCanceled; //!< анализ отменен обработчиком прогресса
+    qint64 progressCounter; //!< количество единиц работы, выполненных на текущей стадии
+    ResultCache* resultCache; //!< кэш результатов анализа (nullptr - не используется), анализатор им не владеет
+    RunStatistics* statistics; //!< статистика запуска, в которой отмечаются стадии проверки и анализа (nullptr - не собирается)
+    TraceRecorder* trace; //!< трассировка проходов разбора, проверки и обхода зон (nullptr - не ведется)
+    QVector<qint64> visitCounts; //!< количество посещений узлов каждой функцией обхода (индекс - TraversalFunction)
+    const ResourceLimits* limits; //!< ограничения ресурсов на разбор, проверку и анализ (nullptr - без ограничений), анализатор ими не владеет
+    bool isLimitExceeded; //!< работа остановлена из-за превышения ограничения, ошибка LimitExceeded уже добавлена
+    QElapsedTimer limitTimer; //!< таймер от начала разбора или повторного анализа для ограничения по времени
+    qint64 limitInputBytes; //!< память текста входа, учитываемая в оценке памяти анализатора
 
     /*!
     * \brief Функция позволяющая записать найденные ошибки в отдельный файл и завершить выполнение программы
@@ -85,6 +162,19 @@ public:
     */
     void clearData();
 
+    /*!
+    * \brief Очищает только результаты анализа покрытия, сохраняя разобранное и проверенное дерево
+    */
+    void clearCoverage();
+
+    /*!
+    * \brief Заменяет отметки дерева: узлы из списка становятся отмеченными, остальные нецелевые узлы - обычными
+    * \param [in] names - имена отмечаемых узлов
+    * \param [out] invalidNames - имена, которых нет в дереве, или имена целевых узлов
+    * \return true - если отметки применены, false - если найдены недопустимые имена (отметки не изменяются)
+    */
+    bool selectNodes(const QStringList& names, QStringList& invalidNames);
+
     /*!
     * \brief Заполнение таблицы узел – количество родителей и вызов валидации графа
     * \param [in] treeMap – список всех узлов которые нашлись при считывании .dot файла
@@ -117,8 +207,96 @@ public:
     */
     void analyzeTreeCoverage();
 
+    /*!
+    * \brief Анализирует покрытие проверенного дерева без записи результата
+    * \param [out] extraNodes, missingNodes, redundantNodes, suggestedNodes – результат анализа
+    */
+    void analyzeCoverage();
+
+    /*!
+    * \brief Анализирует дерево по содержимому DOT-файла в памяти без записи файлов и без завершения программы
+    * \param [in] content – содержимое входного файла в формате DOT
+    * \return результат анализа: итог, ошибки, лишние, недостающие и избыточные узлы
+    */
+    CoverageResult analyze(const QString& content);
+
+    /*!
+    * \brief Анализирует дерево по буферу с содержимым DOT-файла в кодировке UTF-8
+    * \param [in] buffer – содержимое входного файла в формате DOT
+    * \return результат анализа: итог, ошибки, лишние, недостающие и избыточные узлы
+    */
+    CoverageResult analyzeBuffer(const QByteArray& buffer);
+
+    /*!
+    * \brief Разбирает DOT-контент и проверяет, что граф является деревом, без анализа покрытия
+    * \param [in] content – содержимое входного файла в формате DOT
+    * \param [out] status – ParseErrors или GraphErrors, если найдены ошибки
+    * \return true - если дерево корректно и готово к анализу покрытия, false - в противном случае
+    */
+    bool validate(const QString& content, CoverageResult::Status& status);
+
+    /*!
+    * \brief Проверяет, что разобранный граф является деревом
+    * \param [out] status – GraphErrors, если найдены ошибки, Canceled - если проверка отменена
+    * \return true - если дерево корректно и готово к анализу покрытия, false - в противном случае
+    */
+    bool validateGraph(CoverageResult::Status& status);
+
+    /*!
+    * \brief Восстанавливает результат анализа по сохраненному результату с именами узлов, не обходя дерево
+    * \param [in] result – результат анализа того же дерева с теми же отметками
+    * \param [out] errors, extraNodes, missingNodes, redundantNodes, suggestedNodes – восстановленный результат
+    */
+    void applyResult(const CoverageResult& result);
+
+    /*!
+    * \brief Анализирует покрытие дерева, успешно прошедшего проверку validate
+    * \return Covered - если замечаний нет, NotCovered - в противном случае
+    */
+    CoverageResult::Status analyzeValidTree();
+
+    /*!
+    * \brief Запускает разбор и анализ в пуле потоков, результат не зависит от времени жизни вызывающего объекта
+    *
+    * Прогресс будущего результата задается в промилле: разбор 0-500, проверка 500-800, анализ покрытия 800-1000,
+    * текст прогресса описывает стадию. Вызов cancel() у будущего результата прерывает анализ на ближайшей проверке прогресса.
+    * Отмененный будущий результат не содержит значения (resultCount() равен 0), признаком отмены служит isCanceled().
+    * \param [in] content – содержимое входного файла в формате DOT
+    * \param [in] suggestionCount – количество предлагаемых для отметки узлов
+    * \param [in] pool – пул потоков для анализа
+    * \return будущий результат анализа, при отмене - без результата
+    */
+    static QFuture<CoverageResult> analyzeAsync(const QString& content, int suggestionCount = 0, QThreadPool* pool = QThreadPool::globalInstance());
+
+    /*!
+    * \brief Сообщает обработчику прогресса о выполненной работе
+    * \param [in] stage - стадия анализа
+    * \param [in] done - выполнено единиц работы
+    * \param [in] total - всего единиц работы на стадии
+    * \param [out] isCanceled - обработчик запросил отмену
+    * \return false - если анализ отменен
+    */
+    bool reportProgress(AnalysisStage stage, qint64 done, qint64 total);
+
+    /*!
+    * \brief Учитывает одну единицу работы и раз в ProgressInterval единиц вызывает обработчик прогресса
+    * \param [in] stage - стадия анализа, единицей работы которой считается посещенный узел
+    * \return false - если анализ отменен
+    */
+    bool countProgress(AnalysisStage stage);
+
+    /*!
+    * \brief Переносит результат анализа в объект, не ссылающийся на узлы анализатора
+    * \param [in] status – итог анализа
+    * \return результат анализа с именами узлов в порядке treeMap
+    */
+    CoverageResult buildResult(CoverageResult::Status status) const;
+
     /*!
     * \brief Анализирует покрытие зоны в которой возможно находятся лишние узлы
+    *
+    * Правила зон задает CoverageEngine, анализатор добавляет к его обходу прогресс, счетчики посещений
+    * и перенос результатов неизменных поддеревьев предыдущей ревизии.
     * \param [in] node - текущий узел для анализа (изначально корень дерева)
     * \param [out] extraNodes – контейнер с лишними узлами
     */
@@ -142,9 +320,163 @@ public:
 
     /*!
     * \brief Функция получения результата анализа
-    * \param [out] file – файл формата .txt в котором будет составлен вывод о покрытии узла
+    * \param [out] file – файл resultFileName в котором будет составлен вывод о покрытии узла
     */
     void getResult() const;
+
+    /*!
+    * \brief Записывает вывод о покрытии или отчет об ошибках в файл без завершения программы
+    * \param [in] fileName – имя файла для записи в формате resultFormat
+    * \return true - если файл записан, false - если файл не удалось открыть
+    */
+    bool writeResultFile(const QString& fileName) const;
+
+    /*!
+    * \brief Вычисляет хэши всех поддеревьев, начиная с корней графа
+    * \param [out] subtreeHashes – таблица узел - хэш поддерева
+    * \param [out] subtreeIntervals – таблица узел - отрезок номеров узлов поддерева
+    */
+    void computeSubtreeHashes();
+
+    /*!
+    * \brief Рекурсивно вычисляет хэш поддерева по имени и форме узла и хэшам его детей
+    * \param [in] node - корень поддерева
+    * \param [in,out] order - порядковый номер следующего узла при обходе в глубину
+    * \return хэш поддерева
+    */
+    QByteArray hashSubtree(Node* node, int& order);
+
+    /*!
+    * \brief Вычисляет хэш структуры графа: имена узлов и ребра без учета форм узлов
+    * \return хэш, совпадающий у графов, различающихся только атрибутами узлов
+    */
+    QByteArray structureHash() const;
+
+    /*!
+    * \brief Сравнивает текущую ревизию дерева с предыдущей и подготавливает переиспользование ее статусов покрытия
+    * \param [in] previous - снимок предыдущей ревизии, должен существовать до конца анализа
+    * \param [out] changedNodes, addedNodes, removedNodeNames – найденные различия
+    */
+    void diffWith(const RevisionState& previous);
+
+    /*!
+    * \brief Переносит результат анализа неизменного поддерева из предыдущей ревизии
+    * \param [in] node - корень поддерева текущей ревизии
+    * \param [out] status - статус покрытия поддерева
+    * \return true - если поддерево не изменилось и результат перенесен, false - в противном случае
+    */
+    bool reuseCoverage(Node* node, CoverageStatus& status);
+
+    /*!
+    * \brief Восстанавливает статусы внутренних узлов переиспользованных поддеревьев перед выгрузкой покрытия или записью снимка
+    * \param [out] nodeStatuses – таблица узел - статус покрытия
+    */
+    void resolveReusedStatuses();
+
+    /*!
+    * \brief Функция получения отчета о различиях между ревизиями дерева
+    * \param [in] fileName - путь к текстовому файлу, в котором будет составлен отчет
+    */
+    void getDiffResult(const QString& fileName) const;
+
+    /*!
+    * \brief Подсчитывает количество непокрытых листьев в поддереве узла
+    * \param [in] node - корень поддерева
+    * \param [out] uncoveredLeafCounts – таблица узел - количество непокрытых листьев
+    * \return количество листьев типа Base, над которыми нет отмеченных узлов
+    */
+    int countUncoveredLeaves(Node* node);
+
+    /*!
+    * \brief Выбирает k недостающих узлов, отметка которых даст наибольший прирост покрытия
+    * \param [in] k - количество предлагаемых узлов
+    * \return список пар узел - количество листьев, которые он покроет, по убыванию прироста
+    */
+    QList<QPair<Node*, int>> suggestMarks(int k);
+
+    /*!
+    * \brief Записывает вывод о покрытии целевого узла в переданный поток, имена узлов пишутся в поток по одному без сборки в строку
+    * \param [out] out – поток для записи вывода
+    */
+    void writeResult(QTextStream& out) const;
+
+    /*!
+    * \brief Записывает поля результата анализа в JSON-объект: статус, ошибки, целевые, отмеченные, лишние, избыточные и недостающие узлы
+    * \param [out] json – писатель JSON, в котором уже открыт объект
+    */
+    void writeJsonResult(JsonStreamWriter& json) const;
+
+    /*!
+    * \brief Упорядочивает узлы контейнера в порядке treeMap, чтобы вывод не зависел от порядка хэширования
+    * \param [in] nodes - контейнер узлов
+    * \return список узлов в порядке treeMap
+    */
+    QList<Node*> sortedByTreeOrder(const QSet<Node*>& nodes) const;
+
+    /*!
+    * \brief Упорядочивает избыточные узлы в порядке treeMap
+    * \return список пар (отмеченный предок, избыточный узел), упорядоченный по избыточному узлу
+    */
+    QList<QPair<Node*, Node*>> sortedRedundantNodes() const;
+
+    /*!
+    * \brief Разбивает граф на компоненты связности без учета направления связей
+    * \return список компонент, узлы каждой компоненты идут в порядке treeMap
+    */
+    QList<QList<Node*>> splitIntoComponents() const;
+
+    /*!
+    * \brief Проверяет компоненту леса как отдельное дерево и анализирует ее покрытие
+    * \param [out] errors – ошибки найденные в компоненте
+    * \param [out] extraNodes, missingNodes, redundantNodes – результат анализа покрытия компоненты
+    */
+    void analyzeComponent();
+
+    /*!
+    * \brief Режим леса: разбивает граф на компоненты связности и анализирует каждую из них параллельно в пуле потоков
+    * \param [out] forest – анализаторы компонент, узлами которых по-прежнему владеет текущий анализатор
+    */
+    void analyzeForest();
+
+    /*!
+    * \brief Функция получения результата анализа леса, вывод составляется отдельно для каждого корня
+    * \param [out] file – файл resultFileName в котором будет составлен вывод о покрытии
+    */
+    void getForestResult() const;
+
+    /*!
+    * \brief Останавливает работу из-за превышения ограничения: добавляет ошибку LimitExceeded (один раз) и отменяет обход
+    * \param [in] details - описание превышенного ограничения
+    * \return false, чтобы вызывающая функция могла сразу вернуть результат проверки
+    */
+    bool exceedLimit(const QString& details);
+
+    /*!
+    * \brief Начинает отсчет ограничения по времени. Для повторного анализа разобранного дерева
+    *        также снимает остановку и ошибку LimitExceeded предыдущего анализа
+    */
+    void restartLimits();
+
+    /*!
+    * \brief Проверяет ограничения на количество узлов и ребер и оценку памяти анализатора
+    * \param [in] nodeCount - количество узлов
+    * \param [in] edgeCount - количество ребер
+    * \return true - если ограничения соблюдены или не заданы
+    */
+    bool checkGraphLimits(qint64 nodeCount, qint64 edgeCount);
+
+    /*!
+    * \brief Возвращает имя функции обхода для статистики
+    * \param [in] function - функция обхода
+    * \return имя функции
+    */
+    static QString traversalFunctionName(TraversalFunction function);
+
+    /*!
+    * \brief Суммирует посещения узлов анализатором и анализаторами компонент леса
+    * \return количество посещений по функциям обхода (индекс - TraversalFunction)
+    */
+    QVector<qint64> totalVisitCounts() const;
 };
 
 #endif // TREECOVERAGEANALYZER_H